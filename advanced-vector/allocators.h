@@ -0,0 +1,201 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Аллокатор с гарантированным выравниванием базового адреса буфера — для
+// SIMD-ядер, которым нужны выровненные загрузки с самого начала буфера без
+// ручного сдвига. Гарантия переживает регров: каждый новый буфер вектора
+// приходит из этого же аллокатора. Константа Alignment видна вектору как
+// Vector::BufferAlignment — на неё можно ставить static_assert в ядрах
+template <typename T, size_t Align>
+struct AlignedAllocator {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0,
+                  "Align must be a power of two not weaker than alignof(T)");
+
+    static constexpr size_t Alignment = Align;
+
+    T* Allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void Deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf, std::align_val_t{Align});
+    }
+};
+
+// Монотонная арена: выдаёт память сдвигом указателя внутри одного блока.
+// Отдельного освобождения нет — вся арена сбрасывается целиком через Reset
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t capacity) :
+        buf_(static_cast<std::byte*>(operator new(capacity))),
+        capacity_(capacity) {
+    }
+
+    ~MonotonicArena() {
+        operator delete(buf_);
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes > capacity_) {
+            throw std::bad_alloc{};
+        }
+        offset_ = aligned + bytes;
+        return buf_ + aligned;
+    }
+
+    // Возвращает арену в исходное состояние; все выданные ранее блоки становятся недействительными
+    void Reset() noexcept {
+        offset_ = 0;
+    }
+
+    size_t Used() const noexcept {
+        return offset_;
+    }
+
+private:
+    std::byte* buf_;
+    size_t capacity_;
+    size_t offset_ = 0;
+};
+
+// Аллокатор для Vector поверх арены; Deallocate — no-op
+template <typename T>
+class ArenaAllocator {
+public:
+    explicit ArenaAllocator(MonotonicArena& arena) noexcept :
+        arena_(&arena) {
+    }
+
+    T* Allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void Deallocate(T* /*buf*/, size_t /*n*/) noexcept {
+    }
+
+private:
+    MonotonicArena* arena_;
+};
+
+#ifdef __linux__
+
+// Аллокатор поверх анонимного mmap: буфер живёт на собственных страницах,
+// munmap мгновенно возвращает память ОС. Reallocate наращивает отображение
+// через mremap, поэтому Reserve у вектора тривиально перемещаемых типов
+// обходится вовсе без копирования элементов. Файл-backed сценарий собирается
+// из mmap готового файла плюс Vector::Adopt с munmap-делитером — снапшот
+// открывается без десериализации
+template <typename T>
+struct MmapAllocator {
+    T* Allocate(size_t n) {
+        void* p = mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(p);
+    }
+
+    void Deallocate(T* buf, size_t n) noexcept {
+        munmap(buf, n * sizeof(T));
+    }
+
+    T* Reallocate(T* buf, size_t old_n, size_t new_n) noexcept {
+        void* p = mremap(buf, old_n * sizeof(T), new_n * sizeof(T), MREMAP_MAYMOVE);
+        return p != MAP_FAILED ? static_cast<T*>(p) : nullptr;
+    }
+};
+
+#endif  // __linux__
+
+// Пул блоков по классам размеров (степени двойки). Освобождённые блоки
+// попадают в списки свободных и переиспользуются без обращения к operator new.
+// Все векторы, обслуживаемые пулом, должны быть разрушены раньше самого пула
+class PoolResource {
+public:
+    PoolResource() = default;
+
+    ~PoolResource() {
+        for (FreeBlock*& head : free_lists_) {
+            while (head != nullptr) {
+                operator delete(std::exchange(head, head->next));
+            }
+        }
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    void* Allocate(size_t bytes) {
+        const size_t cls = SizeClass(bytes);
+        if (cls > MAX_CLASS) {
+            // Слишком крупные блоки не пулируются
+            return operator new(bytes);
+        }
+        FreeBlock*& head = free_lists_[cls - MIN_CLASS];
+        if (head != nullptr) {
+            return std::exchange(head, head->next);
+        }
+        return operator new(size_t{1} << cls);
+    }
+
+    void Deallocate(void* buf, size_t bytes) noexcept {
+        const size_t cls = SizeClass(bytes);
+        if (cls > MAX_CLASS) {
+            operator delete(buf);
+            return;
+        }
+        FreeBlock*& head = free_lists_[cls - MIN_CLASS];
+        head = new (buf) FreeBlock{head};
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t MIN_CLASS = 6;   // 64 байта
+    static constexpr size_t MAX_CLASS = 20;  // 1 МиБ
+
+    // Номер класса — ближайшая сверху степень двойки, но не меньше минимальной
+    static size_t SizeClass(size_t bytes) noexcept {
+        size_t cls = MIN_CLASS;
+        while (cls <= MAX_CLASS && (size_t{1} << cls) < bytes) {
+            ++cls;
+        }
+        return cls;
+    }
+
+    FreeBlock* free_lists_[MAX_CLASS - MIN_CLASS + 1] = {};
+};
+
+// Аллокатор для Vector поверх пула
+template <typename T>
+class PoolAllocator {
+public:
+    explicit PoolAllocator(PoolResource& pool) noexcept :
+        pool_(&pool) {
+    }
+
+    T* Allocate(size_t n) {
+        return static_cast<T*>(pool_->Allocate(n * sizeof(T)));
+    }
+
+    void Deallocate(T* buf, size_t n) noexcept {
+        pool_->Deallocate(buf, n * sizeof(T));
+    }
+
+private:
+    PoolResource* pool_;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Конкурентное наполнение заранее зарезервированного вектора из нескольких
+// потоков. Сам Vector потокобезопасным не становится: наполнитель раздаёт
+// писателям непересекающиеся слоты атомарным инкрементом индекса, каждый
+// поток конструирует элемент placement new в своём слоте без блокировок.
+// После join всех писателей Seal() отдаёт готовый Vector.
+//
+// Ёмкость фиксируется при создании: реаллокация под конкурентной записью
+// невозможна, переполнение — ошибка программы (ловится assert).
+// Конструкторы элементов обязаны не бросать, иначе в префиксе появился бы
+// «дырявый» слот — это требование проверяется на этапе компиляции
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth>
+class ConcurrentAppender {
+public:
+    using VectorType = Vector<T, InlineCapacity, Alloc, Growth>;
+
+    explicit ConcurrentAppender(size_t capacity, Alloc alloc = Alloc{}) :
+        target_(std::move(alloc)) {
+        target_.Reserve(capacity);
+    }
+
+    ConcurrentAppender(const ConcurrentAppender&) = delete;
+    ConcurrentAppender& operator=(const ConcurrentAppender&) = delete;
+
+    ~ConcurrentAppender() {
+        // Если Seal не вызывался, сконструированный префикс разрушит вектор
+        target_.size_ = next_.load(std::memory_order_relaxed);
+    }
+
+    // Захватывает слот и конструирует в нём элемент; возвращает его индекс.
+    // Можно звать из любого числа потоков одновременно
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        static_assert(std::is_nothrow_constructible_v<T, Args...>,
+                      "ConcurrentAppender requires a non-throwing element constructor");
+        const size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+        assert(index < target_.Capacity());
+        new (target_.Data() + index) T(std::forward<Args>(args)...);
+        return index;
+    }
+
+    size_t PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    size_t PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    // Число уже захваченных слотов; под конкурентной записью — лишь оценка
+    size_t Size() const noexcept {
+        return next_.load(std::memory_order_relaxed);
+    }
+
+    size_t Capacity() const noexcept {
+        return target_.Capacity();
+    }
+
+    // Завершает наполнение и отдаёт вектор. Вызывать строго после join
+    // всех писателей; наполнитель после этого пуст
+    VectorType Seal() {
+        target_.size_ = next_.exchange(0, std::memory_order_relaxed);
+        return std::move(target_);
+    }
+
+private:
+    VectorType target_;
+    std::atomic<size_t> next_ = 0;
+};
@@ -0,0 +1,238 @@
+#pragma once
+#include "vector.h"
+
+// Отсортированный Vector как замена узловым map/set: ключи лежат подряд,
+// поиск — двоичный по непрерывной памяти, обход — линейный проход по кэшу.
+// Вставка и удаление сдвигают хвост (O(n)), поэтому адаптеры рассчитаны на
+// read-mostly словари; массовое наполнение делает Rebuild — одна точная
+// аллокация, сортировка и дедупликация, без n вставок со сдвигами.
+//
+// Итерация — только константная: неконстантная ссылка на ключ позволила бы
+// сломать сортировку. У FlatMap значения правятся через operator[] и At
+
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+public:
+    using VectorType = Vector<K>;
+    using const_iterator = typename VectorType::const_iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(Compare comp) :
+        comp_(std::move(comp)) {
+    }
+
+    template <typename FwdIt>
+    FlatSet(FwdIt first, FwdIt last, Compare comp = Compare{}) :
+        comp_(std::move(comp)) {
+        Rebuild(first, last);
+    }
+
+    size_t Size() const noexcept {
+        return data_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return data_.Size() == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return data_.end();
+    }
+
+    const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(data_.begin(), data_.end(), key, comp_);
+    }
+
+    const_iterator Find(const K& key) const {
+        const_iterator pos = LowerBound(key);
+        return pos != end() && !comp_(key, *pos) ? pos : end();
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    // Вставка с сохранением сортировки: один lower_bound и один сдвиг
+    // хвоста; false — ключ уже есть
+    std::pair<const_iterator, bool> Insert(K value) {
+        const_iterator pos = LowerBound(value);
+        if (pos != end() && !comp_(value, *pos)) {
+            return {pos, false};
+        }
+        return {data_.Insert(pos, std::move(value)), true};
+    }
+
+    size_t Erase(const K& key) {
+        const_iterator pos = Find(key);
+        if (pos == end()) {
+            return 0;
+        }
+        data_.Erase(pos);
+        return 1;
+    }
+
+    const_iterator Erase(const_iterator first, const_iterator last) {
+        return data_.Erase(first, last);
+    }
+
+    // Массовое наполнение: точная аллокация под весь диапазон, сортировка
+    // и дедупликация одним проходом вместо n вставок со сдвигами.
+    // Прежнее содержимое замещается
+    template <typename FwdIt>
+    void Rebuild(FwdIt first, FwdIt last) {
+        VectorType fresh(first, last);
+        std::sort(fresh.begin(), fresh.end(), comp_);
+        auto tail = std::unique(fresh.begin(), fresh.end(), [this](const K& a, const K& b) {
+            return !comp_(a, b) && !comp_(b, a);
+        });
+        fresh.Erase(tail, fresh.end());
+        data_ = std::move(fresh);
+    }
+
+    // Доступ к несущему вектору — для сериализации и срезов
+    const VectorType& Underlying() const noexcept {
+        return data_;
+    }
+
+private:
+    VectorType data_;
+    Compare comp_;
+};
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    using ValueType = std::pair<K, V>;
+    using VectorType = Vector<ValueType>;
+    using const_iterator = typename VectorType::const_iterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(Compare comp) :
+        comp_(std::move(comp)) {
+    }
+
+    template <typename FwdIt>
+    FlatMap(FwdIt first, FwdIt last, Compare comp = Compare{}) :
+        comp_(std::move(comp)) {
+        Rebuild(first, last);
+    }
+
+    size_t Size() const noexcept {
+        return data_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return data_.Size() == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return data_.end();
+    }
+
+    const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(data_.begin(), data_.end(), key,
+                                [this](const ValueType& entry, const K& k) {
+                                    return comp_(entry.first, k);
+                                });
+    }
+
+    const_iterator Find(const K& key) const {
+        const_iterator pos = LowerBound(key);
+        return pos != end() && !comp_(key, pos->first) ? pos : end();
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    std::pair<const_iterator, bool> Insert(ValueType entry) {
+        const_iterator pos = LowerBound(entry.first);
+        if (pos != end() && !comp_(entry.first, pos->first)) {
+            return {pos, false};
+        }
+        return {data_.Insert(pos, std::move(entry)), true};
+    }
+
+    std::pair<const_iterator, bool> InsertOrAssign(K key, V value) {
+        const_iterator pos = LowerBound(key);
+        if (pos != end() && !comp_(key, pos->first)) {
+            MutableEntry(pos).second = std::move(value);
+            return {pos, false};
+        }
+        return {data_.Insert(pos, ValueType{std::move(key), std::move(value)}), true};
+    }
+
+    // Значение по ключу; отсутствующий ключ вставляется со значением по
+    // умолчанию — как у std::map
+    V& operator[](K key) {
+        const_iterator pos = LowerBound(key);
+        if (pos == end() || comp_(key, pos->first)) {
+            pos = data_.Insert(pos, ValueType{std::move(key), V{}});
+        }
+        return MutableEntry(pos).second;
+    }
+
+    V& At(const K& key) {
+        const_iterator pos = Find(key);
+        assert(pos != end());
+        return MutableEntry(pos).second;
+    }
+
+    const V& At(const K& key) const {
+        return const_cast<FlatMap&>(*this).At(key);
+    }
+
+    size_t Erase(const K& key) {
+        const_iterator pos = Find(key);
+        if (pos == end()) {
+            return 0;
+        }
+        data_.Erase(pos);
+        return 1;
+    }
+
+    const_iterator Erase(const_iterator first, const_iterator last) {
+        return data_.Erase(first, last);
+    }
+
+    // Массовое наполнение одной аллокацией; из записей с равными ключами
+    // выживает первая в диапазоне. Прежнее содержимое замещается
+    template <typename FwdIt>
+    void Rebuild(FwdIt first, FwdIt last) {
+        VectorType fresh(first, last);
+        std::stable_sort(fresh.begin(), fresh.end(),
+                         [this](const ValueType& lhs, const ValueType& rhs) {
+                             return comp_(lhs.first, rhs.first);
+                         });
+        auto tail = std::unique(fresh.begin(), fresh.end(),
+                                [this](const ValueType& lhs, const ValueType& rhs) {
+                                    return !comp_(lhs.first, rhs.first)
+                                        && !comp_(rhs.first, lhs.first);
+                                });
+        fresh.Erase(tail, fresh.end());
+        data_ = std::move(fresh);
+    }
+
+    const VectorType& Underlying() const noexcept {
+        return data_;
+    }
+
+private:
+    // Снимает константность записи для правки значения; ключ не трогать
+    ValueType& MutableEntry(const_iterator pos) noexcept {
+        return *(data_.begin() + (pos - data_.begin()));
+    }
+
+    VectorType data_;
+    Compare comp_;
+};
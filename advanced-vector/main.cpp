@@ -1,8 +1,18 @@
 #include "vector.h"
+#include "allocators.h"
+#include "concurrent_appender.h"
+#include "multi_vector.h"
+#include "flat_map.h"
+#include "shared_vector.h"
+#include "serialize.h"
 
 #include <iostream>
+#include <atomic>
+#include <sstream>
+#include <unordered_set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -432,7 +442,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v;
-        auto* pos = v.Emplace(v.end(), Obj{1});
+        auto pos = v.Emplace(v.end(), Obj{1});
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -447,7 +457,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v;
         v.Reserve(SIZE);
-        auto* pos = v.Emplace(v.end(), Obj{1});
+        auto pos = v.Emplace(v.end(), Obj{1});
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -494,7 +504,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
-        auto* pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[1]);
@@ -510,7 +520,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
-        auto* pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[SIZE]);
@@ -529,7 +539,7 @@ void Test6() {
         v.Reserve(SIZE * 2);
         const int old_num_moved = Obj::num_moved;
         assert(v.Capacity() == SIZE * 2);
-        auto* pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(&*pos == &v[3]);
         assert(v[3].id == ID);
@@ -545,7 +555,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
         v[2].id = ID;
-        auto* pos = v.Erase(v.cbegin() + 1);
+        auto pos = v.Erase(v.cbegin() + 1);
         assert((pos - v.begin()) == 1);
         assert(v.Size() == SIZE - 1);
         assert(v.Capacity() == SIZE);
@@ -558,6 +568,1058 @@ void Test6() {
     }
 }
 
+void Test7() {
+    // Быстрый путь для тривиально копируемых типов должен сохранять значения
+    // при реаллокации, вставке в середину и удалении
+    const size_t SIZE = 1000;
+    Vector<int> v;
+    for (size_t i = 0; i < SIZE; ++i) {
+        v.PushBack(static_cast<int>(i));
+    }
+    v.Reserve(SIZE * 4);
+    for (size_t i = 0; i < SIZE; ++i) {
+        assert(v[i] == static_cast<int>(i));
+    }
+
+    auto pos = v.Insert(v.cbegin() + 10, -1);
+    assert(v.Size() == SIZE + 1);
+    assert(*pos == -1);
+    assert(v[9] == 9);
+    assert(v[11] == 10);
+    assert(v[SIZE] == static_cast<int>(SIZE - 1));
+
+    pos = v.Erase(v.cbegin() + 10);
+    assert(v.Size() == SIZE);
+    assert(*pos == 10);
+    assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+    // Вставка элемента самого вектора безопасна и на быстром пути
+    v.Insert(v.cbegin() + 5, v[0]);
+    assert(v[5] == 0);
+}
+
+namespace {
+
+// Тип с бросающим копированием и без перемещения — для проверки откатов
+// путей переноса: копия может бросить в середине
+struct ThrowyCopy {
+    static inline int live = 0;
+    static inline int copies_until_throw = -1;  // -1 — не бросать
+
+    std::string payload = "payload";
+
+    ThrowyCopy() {
+        ++live;
+    }
+
+    ThrowyCopy(const ThrowyCopy& other) :
+        payload(other.payload) {
+        if (copies_until_throw >= 0 && copies_until_throw-- == 0) {
+            throw std::runtime_error("Oops");
+        }
+        ++live;
+    }
+
+    ~ThrowyCopy() {
+        --live;
+    }
+};
+
+}  // namespace
+
+void Test8() {
+    const size_t INLINE = 4;
+    {
+        // Пока элементы помещаются во встроенный буфер, память в куче не выделяется,
+        // а данные лежат внутри самого объекта вектора
+        Vector<int, INLINE> v;
+        assert(v.Capacity() == INLINE);
+        for (int i = 0; i < static_cast<int>(INLINE); ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == INLINE);
+        const auto* obj_begin = reinterpret_cast<const std::byte*>(&v);
+        const auto* obj_end = obj_begin + sizeof(v);
+        const auto* data = reinterpret_cast<const std::byte*>(v.AsSpan().Data());
+        assert(data >= obj_begin && data < obj_end);
+
+        // Переполнение встроенного буфера переводит вектор на кучу
+        v.PushBack(42);
+        assert(v.Size() == INLINE + 1);
+        assert(v.Capacity() == INLINE * 2);
+        data = reinterpret_cast<const std::byte*>(v.AsSpan().Data());
+        assert(!(data >= obj_begin && data < obj_end));
+        for (int i = 0; i < static_cast<int>(INLINE); ++i) {
+            assert(v[i] == i);
+        }
+        assert(v[INLINE] == 42);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, INLINE> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(2);
+        // Перемещение вектора со встроенным буфером переносит элементы поэлементно
+        Vector<Obj, INLINE> moved(std::move(v));
+        assert(moved.Size() == 2);
+        assert(moved[0].id == 1);
+        assert(moved[1].id == 2);
+        assert(Obj::num_moved == 2);
+        assert(Obj::GetAliveObjectCount() == 2);
+
+        Vector<Obj, INLINE> other;
+        other.EmplaceBack(3);
+        other.Swap(moved);
+        assert(other.Size() == 2 && other[0].id == 1);
+        assert(moved.Size() == 1 && moved[0].id == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Копирование и присваивание с встроенным буфером
+        Vector<int, INLINE> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        Vector<int, INLINE> v_copy(v);
+        assert(v_copy.Size() == 2 && v_copy[1] == 2);
+        Vector<int, INLINE> v_assigned;
+        v_assigned = v;
+        assert(v_assigned.Size() == 2 && v_assigned[0] == 1);
+    }
+    {
+        // Move-присваивание от встроенного вектора переносит поэлементно и
+        // может бросить; приёмник при этом остаётся пустым, а не хранит
+        // прежний размер поверх уже разрушенных элементов
+        ThrowyCopy::copies_until_throw = -1;
+        {
+            Vector<ThrowyCopy, INLINE> dst;
+            dst.PushBack(ThrowyCopy{});
+            dst.PushBack(ThrowyCopy{});
+            Vector<ThrowyCopy, INLINE> src;
+            src.PushBack(ThrowyCopy{});
+            src.PushBack(ThrowyCopy{});
+            src.PushBack(ThrowyCopy{});
+
+            ThrowyCopy::copies_until_throw = 1;
+            try {
+                dst = std::move(src);
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            ThrowyCopy::copies_until_throw = -1;
+            assert(dst.Size() == 0);
+            assert(src.Size() == 3 && src[2].payload == "payload");
+        }
+        assert(ThrowyCopy::live == 0);
+    }
+}
+
+void Test9() {
+    {
+        // Вектор поверх монотонной арены: память берётся из арены,
+        // освобождение — no-op, реаллокация тоже идёт через арену
+        MonotonicArena arena(1 << 16);
+        Vector<int, 0, ArenaAllocator<int>> v(ArenaAllocator<int>{arena});
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == 100);
+        assert(v[99] == 99);
+        assert(arena.Used() > 0);
+
+        // Аллокатор переезжает вместе с буфером
+        auto moved(std::move(v));
+        assert(moved.Size() == 100);
+        assert(moved[42] == 42);
+
+        const size_t used = arena.Used();
+        auto copy(moved);
+        assert(arena.Used() > used);
+        assert(copy[99] == 99);
+    }
+    {
+        Obj::ResetCounters();
+        MonotonicArena arena(1 << 16);
+        {
+            Vector<Obj, 0, ArenaAllocator<Obj>> v(ArenaAllocator<Obj>{arena});
+            v.EmplaceBack(1);
+            v.EmplaceBack(2);
+            assert(Obj::GetAliveObjectCount() == 2);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+        arena.Reset();
+        assert(arena.Used() == 0);
+    }
+    {
+        // Пул переиспользует освобождённые блоки того же класса размера
+        PoolResource pool;
+        int* first = nullptr;
+        {
+            Vector<int, 0, PoolAllocator<int>> v(16, PoolAllocator<int>{pool});
+            first = &v[0];
+        }
+        {
+            Vector<int, 0, PoolAllocator<int>> v(16, PoolAllocator<int>{pool});
+            assert(&v[0] == first);
+            assert(v.Size() == 16);
+        }
+    }
+}
+
+void Test10() {
+    using namespace std::literals;
+    {
+        // AppendRange дописывает диапазон за одну реаллокацию
+        std::vector<int> src(1000);
+        for (int i = 0; i < 1000; ++i) {
+            src[i] = i;
+        }
+        Vector<int> v;
+        v.PushBack(-1);
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == 1001);
+        assert(v.Capacity() == 1001);
+        assert(v[0] == -1);
+        assert(v[1] == 0);
+        assert(v[1000] == 999);
+
+        // Повторный Append в свободную ёмкость не реаллоцирует
+        v.Reserve(3000);
+        const auto* data = std::as_const(v).AsSpan().Data();
+        v.AppendRange(src.begin(), src.begin() + 10);
+        assert(v.begin() == data);
+        assert(v.Size() == 1011);
+    }
+    {
+        // Вставка диапазона в середину: с реаллокацией и без
+        std::vector<int> src = {100, 101, 102};
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        auto pos = v.Insert(v.cbegin() + 5, src.begin(), src.end());
+        assert(v.Size() == 13);
+        assert(*pos == 100);
+        assert(v[4] == 4 && v[7] == 102 && v[8] == 5 && v[12] == 9);
+
+        v.Reserve(100);
+        pos = v.Insert(v.cbegin() + 1, src.begin(), src.end());
+        assert(v.Size() == 16);
+        assert(v[0] == 0 && *pos == 100 && v[3] == 102 && v[4] == 1);
+    }
+    {
+        // Нетривиальные элементы: вставка короче и длиннее хвоста
+        Obj::ResetCounters();
+        std::vector<Obj> src;
+        src.emplace_back(1, "a"s);
+        src.emplace_back(2, "b"s);
+        src.emplace_back(3, "c"s);
+        Vector<Obj> v(10);
+        v.Reserve(20);
+        v.Insert(v.cbegin() + 8, src.begin(), src.end());  // хвост короче вставки
+        assert(v.Size() == 13);
+        assert(v[8].id == 1 && v[10].id == 3 && v[12].id == 0);
+        v.Insert(v.cbegin() + 1, src.begin(), src.end());  // хвост длиннее вставки
+        assert(v.Size() == 16);
+        assert(v[1].id == 1 && v[3].id == 3 && v[4].id == 0 && v[11].id == 1);
+        assert(Obj::GetAliveObjectCount() == 16 + 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    {
+        // ResizeForOverwrite меняет размер без зануления новых элементов
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        v.ResizeForOverwrite(1000);
+        assert(v.Size() == 1000);
+        assert(v.Capacity() == 1000);
+        assert(v[0] == 1 && v[1] == 2);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        assert(v[999] == 999);
+
+        v.ResizeForOverwrite(10);
+        assert(v.Size() == 10);
+        assert(v.Capacity() == 1000);
+        assert(v[9] == 9);
+    }
+    {
+        // Конструктор с меткой: размер задан, содержимое не определено до записи
+        Vector<double> v(100, UninitializedTag{});
+        assert(v.Size() == 100);
+        assert(v.Capacity() == 100);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = 0.5;
+        }
+        assert(v[99] == 0.5);
+    }
+}
+
+void Test12() {
+    {
+        // ShrinkToFit реаллоцирует ровно под размер
+        Obj::ResetCounters();
+        Vector<Obj> v(10);
+        v.Reserve(1000);
+        assert(v.Capacity() == 1000);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10);
+        assert(v.Size() == 10);
+        assert(Obj::GetAliveObjectCount() == 10);
+
+        // Повторный вызов — no-op
+        const auto* data = std::as_const(v).AsSpan().Data();
+        v.ShrinkToFit();
+        assert(v.begin() == data);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Пустой вектор после ShrinkToFit отдаёт буфер целиком
+        Vector<int> v;
+        v.Reserve(100);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        // Малый вектор возвращается во встроенный буфер
+        Vector<int, 8> v;
+        for (int i = 0; i < 20; ++i) {
+            v.PushBack(i);
+        }
+        v.Resize(4);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 8);
+        assert(v[3] == 3);
+        const auto* obj_begin = reinterpret_cast<const std::byte*>(&v);
+        const auto* data = reinterpret_cast<const std::byte*>(v.AsSpan().Data());
+        assert(data >= obj_begin && data < obj_begin + sizeof(v));
+    }
+    {
+        // Бросок копии при возврате во встроенный буфер не трогает вектор:
+        // кучевой буфер и элементы на месте, утечек нет
+        ThrowyCopy::copies_until_throw = -1;
+        {
+            Vector<ThrowyCopy, 8> v;
+            for (int i = 0; i < 20; ++i) {
+                v.PushBack(ThrowyCopy{});
+            }
+            v.Resize(4);
+            const int live_before = ThrowyCopy::live;
+            const auto* data_before = v.AsSpan().Data();
+            ThrowyCopy::copies_until_throw = 2;
+            try {
+                v.ShrinkToFit();
+                assert(false);
+            } catch (const std::runtime_error&) {
+            }
+            ThrowyCopy::copies_until_throw = -1;
+            assert(ThrowyCopy::live == live_before);
+            assert(v.Size() == 4 && v.AsSpan().Data() == data_before);
+            assert(v[3].payload == "payload");
+        }
+        assert(ThrowyCopy::live == 0);
+    }
+    {
+        // Reset разрушает элементы и освобождает память
+        Obj::ResetCounters();
+        Vector<Obj> v(100);
+        v.Reset();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.PushBack(Obj{1});
+        assert(v.Size() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test13() {
+    {
+        // Erase диапазона сдвигает хвост один раз
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(v.Size() == 7);
+        assert(*pos == 5);
+        assert(v[0] == 0 && v[1] == 1 && v[2] == 5 && v[6] == 9);
+
+        // Пустой диапазон — no-op
+        pos = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(v.Size() == 7 && *pos == 1);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.cbegin() + 3, v.cend());
+        assert(v.Size() == 3);
+        assert(Obj::GetAliveObjectCount() == 3);
+
+        // EraseIf удаляет по предикату за один проход
+        const size_t removed = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 0;
+        });
+        assert(removed == 2);
+        assert(v.Size() == 1);
+        assert(v[0].id == 1);
+        assert(Obj::GetAliveObjectCount() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // SwapRemove: O(1), порядок не сохраняется
+        Vector<int> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        const auto* data = std::as_const(v).AsSpan().Data();
+        auto pos = v.SwapRemove(v.cbegin() + 1);
+        assert(v.Size() == 4);
+        assert(*pos == 4);
+        assert(v.begin() == data);
+
+        // Удаление последнего элемента — просто PopBack
+        v.SwapRemove(v.cbegin() + 3);
+        assert(v.Size() == 3);
+        assert(v[0] == 0 && v[1] == 4 && v[2] == 2);
+    }
+}
+
+void Test14() {
+    {
+        // Политика точного роста: ёмкость растёт ровно до требуемой
+        Vector<int, 0, NewDeleteAllocator<int>, ExactGrowth> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 1);
+        v.PushBack(2);
+        assert(v.Capacity() == 2);
+        v.PushBack(3);
+        assert(v.Capacity() == 3);
+        assert(v[0] == 1 && v[2] == 3);
+    }
+    {
+        // Полуторный рост
+        Vector<int, 0, NewDeleteAllocator<int>, RatioGrowth<3, 2>> v;
+        v.Reserve(4);
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 6);
+        assert(v.Size() == 5);
+        assert(v[4] == 4);
+    }
+    {
+        // Политика применяется и к пакетной вставке
+        std::vector<int> src(100, 7);
+        Vector<int, 0, NewDeleteAllocator<int>, ExactGrowth> v;
+        v.PushBack(0);
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Capacity() == 101);
+        assert(v.Size() == 101);
+    }
+}
+
+#if VECTOR_HAS_CONSTEXPR20
+namespace {
+
+// Таблица, построенная вектором целиком на этапе компиляции
+constexpr int BuildTableAndSum() {
+    Vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(i);
+    }
+    v.Resize(12);
+    v.Reserve(100);
+    v.PopBack();
+    int sum = 0;
+    for (size_t i = 0; i < v.Size(); ++i) {
+        sum += v[i];
+    }
+    return sum;
+}
+
+static_assert(BuildTableAndSum() == 45);
+static_assert([] {
+    Vector<int> v(4);
+    auto moved = std::move(v);
+    return moved.Size() == 4 && moved[3] == 0;
+}());
+
+}  // namespace
+#endif
+
+namespace {
+
+// Тип с деструктором и move-семантикой, но тривиально перемещаемый:
+// владеет указателем, копирование байтов + отказ от источника корректны
+struct Handle {
+    Handle() = default;
+    explicit Handle(int value) : ptr(new int(value)) {
+        ++live;
+    }
+    Handle(Handle&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {
+        ++moves;
+    }
+    Handle& operator=(Handle&& other) noexcept {
+        delete ptr;
+        ptr = std::exchange(other.ptr, nullptr);
+        return *this;
+    }
+    ~Handle() {
+        ++dtors;
+        if (ptr != nullptr) {
+            --live;
+        }
+        delete ptr;
+    }
+
+    int* ptr = nullptr;
+    static inline int live = 0;
+    static inline int moves = 0;
+    static inline int dtors = 0;
+};
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {};
+
+void Test16() {
+    static_assert(IsTriviallyRelocatableV<int>);
+    static_assert(!IsTriviallyRelocatableV<std::string>);
+    static_assert(IsTriviallyRelocatableV<Handle>);
+
+    Handle::live = 0;
+    {
+        Vector<Handle> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(Handle::live == 100);
+
+        // Реаллокация через Reserve — ни перемещений, ни деструкторов
+        const int moves = Handle::moves;
+        const int dtors = Handle::dtors;
+        v.Reserve(v.Capacity() * 2);
+        assert(Handle::moves == moves);
+        assert(Handle::dtors == dtors);
+        assert(*v[42].ptr == 42);
+
+        // Регров через Emplace в середину тоже идёт через bulk-перенос
+        v.ShrinkToFit();
+        v.Emplace(v.cbegin() + 50, 500);
+        assert(Handle::moves == moves);
+        assert(*v[50].ptr == 500);
+        assert(*v[51].ptr == 50);
+        assert(Handle::live == 101);
+    }
+    assert(Handle::live == 0);
+}
+
+namespace {
+
+struct ThrowingMoveAssign {
+    ThrowingMoveAssign() = default;
+    ThrowingMoveAssign(ThrowingMoveAssign&&) noexcept = default;
+    ThrowingMoveAssign& operator=(ThrowingMoveAssign&&) {
+        return *this;
+    }
+};
+
+}  // namespace
+
+void Test15() {
+    // noexcept-поверхность: перемещение вектора и Erase не бросают,
+    // если не бросают операции элемента
+    static_assert(std::is_nothrow_move_constructible_v<Vector<int>>);
+    static_assert(std::is_nothrow_move_assignable_v<Vector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<Vector<Vector<int>>>);
+
+    Vector<int> vi(1);
+    static_assert(noexcept(vi.Erase(vi.cbegin())));
+    static_assert(noexcept(vi.Erase(vi.cbegin(), vi.cend())));
+    static_assert(noexcept(vi.SwapRemove(vi.cbegin())));
+    static_assert(noexcept(vi.Swap(vi)));
+    static_assert(noexcept(vi.PopBack()));
+
+    Vector<ThrowingMoveAssign> vt(1);
+    static_assert(!noexcept(vt.Erase(vt.cbegin())));
+    static_assert(!noexcept(vt.SwapRemove(vt.cbegin())));
+
+    // Благодаря nothrow-перемещению вложенный вектор при регрове
+    // переносится, а не копируется
+    Obj::ResetCounters();
+    Vector<Vector<Obj>> nested;
+    nested.EmplaceBack(Vector<Obj>(10));
+    const int copies = Obj::num_copied;
+    nested.EmplaceBack(Vector<Obj>(10));  // регров внешнего вектора
+    assert(Obj::num_copied == copies);
+    assert(Obj::GetAliveObjectCount() == 20);
+}
+
+void Test17() {
+    const size_t N = 1u << 18;
+
+    // Параллельное конструирование нулей и копирование; результат
+    // неотличим от последовательного
+    Vector<int> v(N, Parallelism{4});
+    assert(v.Size() == N);
+    for (size_t i = 0; i < N; ++i) {
+        assert(v[i] == 0);
+    }
+    for (size_t i = 0; i < N; ++i) {
+        v[i] = static_cast<int>(i);
+    }
+
+    Vector<int> copy(v, Parallelism{4});
+    assert(copy.Size() == N);
+    assert(copy[0] == 0 && copy[N - 1] == static_cast<int>(N - 1));
+
+    // ResizeParallel растит и ужимает так же, как Resize
+    copy.ResizeParallel(2 * N, Parallelism{4});
+    assert(copy.Size() == 2 * N);
+    assert(copy[N - 1] == static_cast<int>(N - 1) && copy[N] == 0);
+    copy.ResizeParallel(10, Parallelism{4});
+    assert(copy.Size() == 10 && copy[9] == 9);
+
+    // Бросающий конструктор — последовательный запасной путь,
+    // счётчики Obj не гоняются между потоками
+    Obj::ResetCounters();
+    {
+        Vector<Obj> vo(1000, Parallelism{4});
+        assert(Obj::GetAliveObjectCount() == 1000);
+        vo.ResizeParallel(0, Parallelism{4});
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+namespace {
+
+int custom_deleter_calls = 0;
+
+}  // namespace
+
+void Test18() {
+    // Adopt: готовый буфер встраивается в вектор без копирования
+    const size_t CAP = 16;
+    int* buf = static_cast<int*>(operator new(CAP * sizeof(int)));
+    for (int i = 0; i < 10; ++i) {
+        new (buf + i) int(i);
+    }
+
+    custom_deleter_calls = 0;
+    {
+        Vector<int> v;
+        v.Adopt(buf, 10, CAP, [](int* p, size_t /*cap*/) {
+            ++custom_deleter_calls;
+            operator delete(p);
+        });
+        assert(v.Size() == 10 && v.Capacity() == CAP);
+        assert(v.begin() == buf);
+        assert(v[7] == 7);
+
+        // До исчерпания ёмкости буфер остаётся тем же
+        v.PushBack(10);
+        assert(v.begin() == buf);
+
+        // Регров освобождает принятый буфер его же deleter-ом
+        v.Reserve(CAP * 2);
+        assert(custom_deleter_calls == 1);
+        assert(v[10] == 10);
+    }
+
+    // Release: буфер переживает вектор и освобождается получателем
+    Vector<int> donor;
+    for (int i = 0; i < 100; ++i) {
+        donor.PushBack(i);
+    }
+    const size_t size = donor.Size();
+    const size_t cap = donor.Capacity();
+    int* taken = donor.Release();
+    assert(donor.Size() == 0 && donor.Capacity() == 0);
+    assert(taken[99] == 99);
+    donor.PushBack(-1);  // вектор остаётся рабочим
+    assert(donor[0] == -1);
+
+    std::destroy_n(taken, size);
+    NewDeleteAllocator<int>{}.Deallocate(taken, cap);
+}
+
+void Test19() {
+#ifdef __linux__
+    // mmap-хранилище: обычная работа вектора плюс рост через mremap —
+    // Reserve тривиального типа не трогает сами элементы
+    Vector<int, 0, MmapAllocator<int>> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(i);
+    }
+    v.Reserve(1u << 20);
+    assert(v.Capacity() == 1u << 20);
+    for (int i = 0; i < 1000; ++i) {
+        assert(v[i] == i);
+    }
+    v.Resize(1u << 20);
+    assert(v[999] == 999 && v[(1u << 20) - 1] == 0);
+
+    // Нетривиальный тип с mmap-аллокатором идёт обычным путём переноса
+    Vector<std::string, 0, MmapAllocator<std::string>> vs;
+    vs.PushBack(std::string(64, 'x'));
+    vs.Reserve(100);
+    assert(vs[0] == std::string(64, 'x'));
+#endif
+}
+
+namespace {
+
+struct Tracked {
+    Tracked() noexcept {
+        ++live;
+    }
+    Tracked(const Tracked&) noexcept {
+        ++live;
+    }
+    ~Tracked() {
+        --live;
+    }
+    static inline int live = 0;
+};
+
+}  // namespace
+
+void Test20() {
+    const size_t THREADS = 4;
+    const size_t PER_THREAD = 25'000;
+
+    ConcurrentAppender<int> appender(THREADS * PER_THREAD);
+    assert(appender.Capacity() == THREADS * PER_THREAD);
+
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < THREADS; ++t) {
+        writers.emplace_back([&appender, t] {
+            for (size_t i = 0; i < PER_THREAD; ++i) {
+                appender.EmplaceBack(static_cast<int>(t * PER_THREAD + i));
+            }
+        });
+    }
+    for (auto& w : writers) {
+        w.join();
+    }
+    assert(appender.Size() == THREADS * PER_THREAD);
+
+    Vector<int> v = appender.Seal();
+    assert(v.Size() == THREADS * PER_THREAD);
+    assert(appender.Size() == 0);
+
+    // Каждое значение встречается ровно один раз — слоты не пересеклись
+    std::vector<char> seen(THREADS * PER_THREAD, 0);
+    for (size_t i = 0; i < v.Size(); ++i) {
+        assert(v[i] >= 0 && static_cast<size_t>(v[i]) < seen.size());
+        assert(!seen[v[i]]);
+        seen[v[i]] = 1;
+    }
+
+    // Незапечатанный наполнитель разрушает сконструированный префикс сам
+    {
+        ConcurrentAppender<Tracked> partial(100);
+        for (int i = 0; i < 60; ++i) {
+            partial.EmplaceBack();
+        }
+        assert(Tracked::live == 60);
+    }
+    assert(Tracked::live == 0);
+}
+
+void Test21() {
+    // Тривиальный тип: заголовок + один bulk-вывод буфера, чтение — прямо
+    // в неинициализированный буфер
+    Vector<int> src;
+    for (int i = 0; i < 1000; ++i) {
+        src.PushBack(i * i);
+    }
+    std::stringstream stream;
+    WriteTo(src, stream);
+    assert(stream.str().size() == sizeof(VectorIoHeader) + 1000 * sizeof(int));
+
+    Vector<int> loaded = ReadFrom<int>(stream);
+    assert(loaded.Size() == src.Size());
+    assert(std::equal(loaded.begin(), loaded.end(), src.begin()));
+
+    // Битый заголовок — исключение, а не мусор
+    std::stringstream garbage("definitely not a vector");
+    try {
+        ReadFrom<int>(garbage);
+        assert(false && "Exception is expected");
+    } catch (const std::runtime_error&) {
+    }
+
+    // Нетривиальный тип ходит через кодек, кадрирование общее
+    Vector<std::string> names;
+    names.PushBack("alpha");
+    names.PushBack("");
+    names.PushBack(std::string(300, 'z'));
+
+    std::stringstream text_stream;
+    WriteTo(names, text_stream, [](std::ostream& out, const std::string& s) {
+        const uint64_t len = s.size();
+        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.write(s.data(), static_cast<std::streamsize>(len));
+    });
+    Vector<std::string> parsed = ReadFrom<std::string>(text_stream, [](std::istream& in) {
+        uint64_t len = 0;
+        in.read(reinterpret_cast<char*>(&len), sizeof(len));
+        std::string s(len, '\0');
+        in.read(s.data(), static_cast<std::streamsize>(len));
+        return s;
+    });
+    assert(parsed.Size() == 3);
+    assert(parsed[0] == "alpha" && parsed[1].empty() && parsed[2] == std::string(300, 'z'));
+
+#ifdef __unix__
+    // Дескрипторный вариант: один writev на запись
+    int fds[2];
+    [[maybe_unused]] const int rc = pipe(fds);
+    assert(rc == 0);
+    WriteTo(src, fds[1]);
+    close(fds[1]);
+    Vector<int> piped = ReadFrom<int>(fds[0]);
+    close(fds[0]);
+    assert(piped.Size() == src.Size());
+    assert(std::equal(piped.begin(), piped.end(), src.begin()));
+#endif
+}
+
+void Test22() {
+    // Assign поверх живых элементов: буфер и адреса стабильны,
+    // конструирование/разрушение — только на разнице размеров
+    Obj::ResetCounters();
+    Vector<Obj> v(10);
+    const Obj* stable = &v[0];
+
+    Vector<Obj> src;
+    for (int i = 0; i < 7; ++i) {
+        src.EmplaceBack(i);
+    }
+
+    v.Assign(src.begin(), src.end());
+    assert(v.Size() == 7);
+    assert(&v[0] == stable);
+    assert(Obj::num_assigned == 7);
+    assert(Obj::GetAliveObjectCount() == 7 + 7);
+    assert(v[3].id == 3);
+
+    // Рост в пределах ёмкости: часть присваивается, хвост доконструируется
+    Vector<Obj> bigger;
+    for (int i = 0; i < 9; ++i) {
+        bigger.EmplaceBack(100 + i);
+    }
+    const int assigned = Obj::num_assigned;
+    const int copied = Obj::num_copied;
+    v.Assign(bigger.begin(), bigger.end());
+    assert(v.Size() == 9);
+    assert(&v[0] == stable);
+    assert(Obj::num_assigned == assigned + 7);
+    assert(Obj::num_copied == copied + 2);
+    assert(v[8].id == 108);
+
+    // Переполнение ёмкости — реаллокация через временный вектор и Swap
+    Vector<Obj> huge;
+    for (int i = 0; i < 50; ++i) {
+        huge.EmplaceBack(i);
+    }
+    v.Assign(huge.begin(), huge.end());
+    assert(v.Size() == 50 && v.Capacity() == 50);
+    assert(v[49].id == 49);
+
+    // Assign(n, value) по той же схеме
+    Vector<int> vi;
+    vi.Assign(100, 42);
+    assert(vi.Size() == 100 && vi[99] == 42);
+    const int* data = &vi[0];
+    vi.Assign(5, 7);
+    assert(vi.Size() == 5 && &vi[0] == data && vi[4] == 7);
+    vi.Assign(60, 9);
+    assert(vi.Size() == 60 && &vi[0] == data && vi[0] == 9 && vi[59] == 9);
+}
+
+void Test23() {
+#ifdef VECTOR_ENABLE_STATS
+    VectorStats::Reset();
+    {
+        Vector<int> v;
+        v.Reserve(100);
+
+        VectorStats after_reserve = VectorStats::Snapshot();
+        assert(after_reserve.allocations == 1);
+        assert(after_reserve.bytes_requested == 100 * sizeof(int));
+        assert(after_reserve.peak_allocation_bytes == 100 * sizeof(int));
+        assert(after_reserve.regrows == 1);
+        assert(after_reserve.elements_relocated == 0);
+
+        for (int i = 0; i < 150; ++i) {
+            v.PushBack(i);
+        }
+        VectorStats after_grow = VectorStats::Snapshot();
+        assert(after_grow.regrows == 2);  // 100 -> 200
+        assert(after_grow.elements_relocated == 100);
+        assert(after_grow.peak_allocation_bytes == 200 * sizeof(int));
+    }
+    VectorStats done = VectorStats::Snapshot();
+    assert(done.deallocations == done.allocations);
+#else
+    // Без -DVECTOR_ENABLE_STATS хуки пустые, Snapshot всегда нулевой
+    Vector<int> v(1000);
+    VectorStats s = VectorStats::Snapshot();
+    assert(s.allocations == 0 && s.regrows == 0 && s.bytes_requested == 0);
+#endif
+}
+
+void Test24() {
+    // Пакетное слияние в отсортированный вектор
+    Vector<int> v;
+    for (int i = 0; i < 100; i += 2) {
+        v.PushBack(i);  // 0, 2, ..., 98
+    }
+    const int batch[] = {99, 1, 55, -10, 1, 200};
+    v.InsertSorted(std::begin(batch), std::end(batch));
+    assert(v.Size() == 56);
+    assert(std::is_sorted(v.begin(), v.end()));
+    assert(v[0] == -10 && v[55] == 200);
+    assert(std::count(v.begin(), v.end(), 1) == 2);
+
+    // Каждый существующий элемент переносится не более одного раза:
+    // при достаточной ёмкости слияние K в N стоит не более N перемещений
+    // существующих элементов (плюс K переносов из пакета)
+    Vector<Obj> sorted;
+    sorted.Reserve(64);
+    for (int i = 0; i < 40; ++i) {
+        sorted.EmplaceBack(i * 10);
+    }
+    Vector<Obj> incoming;
+    for (int i = 0; i < 8; ++i) {
+        incoming.EmplaceBack(i * 50 + 5);
+    }
+    const auto by_id = [](const Obj& lhs, const Obj& rhs) {
+        return lhs.id < rhs.id;
+    };
+    Obj::ResetCounters();
+    sorted.InsertSorted(incoming.begin(), incoming.end(), by_id);
+    assert(sorted.Size() == 48);
+    assert(std::is_sorted(sorted.begin(), sorted.end(), by_id));
+    assert(Obj::num_moved + Obj::num_move_assigned <= 40 + 4 * 8);  // + перемещения сортировки пакета
+    // Счётчики сброшены перед слиянием: с того момента родилось 8 новых слотов
+    assert(Obj::GetAliveObjectCount() == 8);
+
+    // Одиночная вставка по месту; равные ключи сохраняют порядок прибытия
+    Vector<int> single;
+    single.EmplaceSorted(5);
+    single.EmplaceSorted(1);
+    single.EmplaceSorted(9);
+    single.EmplaceSorted(5);
+    assert(single.Size() == 4);
+    assert(std::is_sorted(single.begin(), single.end()));
+    assert(single[0] == 1 && single[1] == 5 && single[2] == 5 && single[3] == 9);
+}
+
+void Test25() {
+    // Конструктор из диапазона: одна аллокация точно под размер
+    std::vector<int> rows{3, 1, 4, 1, 5, 9, 2, 6};
+    Vector<int> v(rows.begin(), rows.end());
+    assert(v.Size() == rows.size());
+    assert(v.Capacity() == rows.size());
+    assert(std::equal(v.begin(), v.end(), rows.begin()));
+
+    // Список инициализации
+    Vector<std::string> words{"one", "two", "three"};
+    assert(words.Size() == 3 && words.Capacity() == 3);
+    assert(words[2] == "three");
+
+    // Заполняющий конструктор
+    Vector<std::string> filled(5, std::string("x"));
+    assert(filled.Size() == 5 && filled.Capacity() == 5);
+    assert(filled[0] == "x" && filled[4] == "x");
+
+    // Vector<int>(5, 3) — пять троек, а не диапазон
+    Vector<int> five_threes(5, 3);
+    assert(five_threes.Size() == 5 && five_threes[4] == 3);
+
+    // Пустой диапазон — без аллокации
+    Vector<int> empty(rows.end(), rows.end());
+    assert(empty.Size() == 0 && empty.Capacity() == 0);
+}
+
+void Test26() {
+    // SoA: три дорожки в одном блоке, рост — одна аллокация на все
+    MultiVector<float, float, int32_t> book;
+    for (int i = 0; i < 1000; ++i) {
+        book.PushBack(static_cast<float>(i) * 1.5f, static_cast<float>(i) * 2.0f, i);
+    }
+    assert(book.Size() == 1000);
+
+    // Дорожки непрерывны, выровнены и пережили серию регровов
+    Span<float> px = book.Lane<0>();
+    Span<float> qty = book.Lane<1>();
+    Span<const int32_t> ids = static_cast<const MultiVector<float, float, int32_t>&>(book).Lane<2>();
+    assert(px.Size() == 1000 && qty.Size() == 1000 && ids.Size() == 1000);
+    assert(reinterpret_cast<uintptr_t>(px.Data()) % alignof(float) == 0);
+    assert(reinterpret_cast<uintptr_t>(ids.Data()) % alignof(int32_t) == 0);
+    for (int i = 0; i < 1000; ++i) {
+        assert(px[i] == static_cast<float>(i) * 1.5f);
+        assert(qty[i] == static_cast<float>(i) * 2.0f);
+        assert(ids[i] == i);
+    }
+
+    book.Get<0>(0) = -1.0f;
+    assert(px.Data()[0] == -1.0f);
+
+    // Нетривиальная дорожка: конструкторы/деструкторы ходят парой
+    Obj::ResetCounters();
+    {
+        MultiVector<int, Obj> tagged;
+        for (int i = 0; i < 100; ++i) {
+            tagged.PushBack(int(i), Obj(i));
+        }
+        assert(Obj::GetAliveObjectCount() == 100);
+        assert(tagged.Get<1>(42).id == 42);
+        tagged.PopBack();
+        assert(Obj::GetAliveObjectCount() == 99);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // Span: срезы без владения
+    Span<float> head = px.First(10);
+    assert(head.Size() == 10 && &head.Back() == px.Data() + 9);
+    assert(px.Subspan(5, 3).Data() == px.Data() + 5);
+
+    // Бросок копии при переносе одной из дорожек не приводит к повторному
+    // разрушению источников других дорожек: контейнер цел, утечек нет.
+    // Бросающая дорожка идёт ВТОРОЙ: дорожка строк уже перенесена, и при
+    // откате её источники должны разрушиться ровно один раз
+    ThrowyCopy::copies_until_throw = -1;
+    {
+        MultiVector<std::string, ThrowyCopy> rows;
+        for (int i = 0; i < 4; ++i) {
+            rows.PushBack(std::string("row"), ThrowyCopy{});
+        }
+        const int live_before = ThrowyCopy::live;
+        ThrowyCopy::copies_until_throw = 2;  // упадёт посреди переноса дорожки 1
+        try {
+            rows.Reserve(rows.Capacity() * 2);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        ThrowyCopy::copies_until_throw = -1;
+        assert(ThrowyCopy::live == live_before);
+        assert(rows.Size() == 4 && rows.Get<0>(3) == "row");
+    }
+    assert(ThrowyCopy::live == 0);
+}
+
 struct C {
     C() noexcept {
         ++def_ctor;
@@ -609,6 +1671,388 @@ void Dump() {
          << ", Dtors: "sv << C::dtor << endl;
 }
 
+void Test27() {
+    // Аллокатор с гарантированным выравниванием: база буфера кратна 64
+    // после любого числа регровов — можно писать SIMD-ядра без пролога
+    using AlignedVec = Vector<float, 0, AlignedAllocator<float, 64>>;
+    static_assert(AlignedVec::BufferAlignment == 64);
+    static_assert(Vector<float>::BufferAlignment == alignof(float));
+
+    AlignedVec v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(static_cast<float>(i));
+        assert(reinterpret_cast<uintptr_t>(v.AsSpan().Data()) % AlignedVec::BufferAlignment == 0);
+    }
+    assert(v.Size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        assert(v[i] == static_cast<float>(i));
+    }
+
+    // Выравнивание сохраняется и при явном Reserve, и при копировании
+    v.Reserve(5000);
+    assert(reinterpret_cast<uintptr_t>(v.AsSpan().Data()) % 64 == 0);
+    AlignedVec copy = v;
+    assert(reinterpret_cast<uintptr_t>(copy.AsSpan().Data()) % 64 == 0);
+    assert(copy.Size() == v.Size());
+}
+
+void Test28() {
+    // Равенство: для int срабатывает memcmp-путь, результат тот же, что у
+    // поэлементного сравнения
+    Vector<int> a;
+    Vector<int> b;
+    for (int i = 0; i < 100; ++i) {
+        a.PushBack(i);
+        b.PushBack(i);
+    }
+    assert(a == b);
+    assert(!(a != b));
+    b[50] = -1;
+    assert(a != b);
+    b[50] = 50;
+    b.PushBack(100);
+    assert(a != b && a < b && b > a && a <= b && b >= a);
+    assert(a <= a && a >= a);
+
+    // Вектора с разными ёмкостями/политиками сравнимы между собой
+    Vector<int, 4> small;
+    small.PushBack(0);
+    small.PushBack(1);
+    Vector<int> big;
+    big.PushBack(0);
+    big.PushBack(1);
+    assert(small == big);
+
+    // float идёт поэлементно: -0.0f == 0.0f, хотя байты различаются
+    Vector<float> f1;
+    Vector<float> f2;
+    f1.PushBack(0.0f);
+    f2.PushBack(-0.0f);
+    assert(f1 == f2);
+
+    // Хеш: равные вектора — равные хеши, и вектор работает ключом
+    assert(a.Hash() == a.Hash());
+    Vector<int> a2 = a;
+    assert(a2.Hash() == a.Hash());
+    assert(a.Hash() != b.Hash());
+
+    std::unordered_set<Vector<int>> keys;
+    keys.insert(std::move(a2));
+    keys.insert(std::move(b));
+    assert(keys.size() == 2);
+    assert(keys.count(a) == 1);
+
+    // Нетривиальный тип комбинируется через std::hash поэлементно
+    Vector<std::string> words;
+    words.PushBack("alpha");
+    words.PushBack("beta");
+    Vector<std::string> words2 = words;
+    assert(words == words2 && words.Hash() == words2.Hash());
+    words2[1] = "gamma";
+    assert(words != words2);
+}
+
+void Test29() {
+    // Копия SharedVector — инкремент счётчика, буфер общий
+    SharedVector<int> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.PushBack(i);
+    }
+    SharedVector<int> b = a;
+    assert(a.UseCount() == 2 && b.UseCount() == 2);
+    assert(a.begin() == b.begin());
+
+    // Мутация отцепляет только мутируемую копию; остальные видят старое
+    b.PushBack(1000);
+    assert(a.UseCount() == 1 && b.UseCount() == 1);
+    assert(a.begin() != b.begin());
+    assert(a.Size() == 1000 && b.Size() == 1001);
+    assert(a[999] == 999 && b[1000] == 1000);
+
+    // Неразделённый буфер мутируется на месте, без клона
+    const int* before = b.begin();
+    b[0] = -1;
+    assert(b.begin() == before && b[0] == -1 && a[0] == 0);
+
+    // Читатели в 8 потоков поверх общих копий — без синхронизации
+    std::atomic<long long> total{0};
+    {
+        Vector<std::thread> readers;
+        for (int t = 0; t < 8; ++t) {
+            readers.EmplaceBack([copy = a, &total] {
+                long long sum = 0;
+                for (int x : copy) {
+                    sum += x;
+                }
+                total.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (size_t t = 0; t < readers.Size(); ++t) {
+            readers[t].join();
+        }
+    }
+    assert(total.load() == 8ll * 999 * 1000 / 2);
+    assert(a.UseCount() == 1);
+
+    // Глубокая копия при Detach не теряет объекты
+    Obj::ResetCounters();
+    {
+        SharedVector<Obj> src;
+        src.Mutable().Resize(16);
+        SharedVector<Obj> dst = src;
+        dst.EmplaceBack();
+        assert(src.Size() == 16 && dst.Size() == 17);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+
+// Аллокатор с лимитом: выше лимита AllocateNoThrow возвращает nullptr —
+// имитация нехватки памяти для проверки Try*-путей
+template <typename T>
+struct BudgetAllocator {
+    size_t max_elements = 64;
+
+    T* Allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T)));
+    }
+
+    T* AllocateNoThrow(size_t n) noexcept {
+        if (n > max_elements) {
+            return nullptr;
+        }
+        return static_cast<T*>(operator new(n * sizeof(T), std::nothrow));
+    }
+
+    void Deallocate(T* buf, size_t /*n*/) noexcept {
+        operator delete(buf);
+    }
+};
+
+}  // namespace
+
+void Test30() {
+    // Удачный путь: TryReserve растит ёмкость, TryEmplaceBack возвращает слот
+    Vector<int, 0, BudgetAllocator<int>> v;
+    assert(v.TryReserve(16));
+    assert(v.Capacity() >= 16);
+    for (int i = 0; i < 40; ++i) {
+        int* slot = v.TryEmplaceBack(i);
+        assert(slot != nullptr && *slot == i);
+    }
+    assert(v.Size() == 40);
+
+    // Нехватка памяти: false/nullptr, вектор не тронут
+    const size_t size_before = v.Size();
+    const size_t cap_before = v.Capacity();
+    const int* data_before = v.begin();
+    assert(!v.TryReserve(1000));
+    assert(v.Size() == size_before && v.Capacity() == cap_before && v.begin() == data_before);
+
+    while (v.Size() < v.Capacity()) {
+        assert(v.TryEmplaceBack(0) != nullptr);
+    }
+    assert(v.TryEmplaceBack(1) == nullptr);  // рост до 128 превышает лимит
+    assert(v.Size() == v.Capacity() && v.begin() == data_before);
+
+    // У обычного вектора Try-API работает поверх nothrow-new
+    Vector<int> plain;
+    for (int i = 0; i < 1000; ++i) {
+        assert(plain.TryPushBack(i) != nullptr);
+    }
+    assert(plain.Size() == 1000 && plain[999] == 999);
+
+    // Аргумент может ссылаться на элемент самого вектора: при регрове он
+    // конструируется в новый буфер до переноса старого
+    Vector<int> alias;
+    alias.PushBack(42);
+    while (alias.Size() < alias.Capacity()) {
+        alias.PushBack(0);
+    }
+    assert(alias.TryPushBack(alias[0]) != nullptr);  // регров ровно в этот вызов
+    assert(*(alias.end() - 1) == 42);
+}
+
+void Test31() {
+    Vector<int> big;
+    for (int i = 0; i < 100000; ++i) {
+        big.PushBack(i);
+    }
+
+    // Срезы — виды поверх буфера, без аллокаций и копий
+    Span<int> whole = big.AsSpan();
+    assert(whole.Data() == big.begin() && whole.Size() == big.Size());
+    assert(big.First(10).Size() == 10 && big.First(10)[9] == 9);
+    assert(big.Last(10)[9] == 99999);
+    assert(big.Subspan(500, 100).Data() == big.begin() + 500);
+
+    // Фан-аут по 16 воркерам кусками одного буфера
+    constexpr size_t WORKERS = 16;
+    std::atomic<long long> total{0};
+    {
+        Vector<std::thread> pool;
+        const size_t chunk = big.Size() / WORKERS;
+        for (size_t w = 0; w < WORKERS; ++w) {
+            const size_t count = w + 1 == WORKERS ? big.Size() - w * chunk : chunk;
+            Span<const int> part = big.Subspan(w * chunk, count);
+            pool.EmplaceBack([part, &total] {
+                long long sum = 0;
+                for (int x : part) {
+                    sum += x;
+                }
+                total.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (size_t w = 0; w < pool.Size(); ++w) {
+            pool[w].join();
+        }
+    }
+    assert(total.load() == 99999ll * 100000 / 2);
+
+    // Запись через неконстантный срез видна в векторе
+    big.Subspan(0, 3)[1] = -7;
+    assert(big[1] == -7);
+    big[1] = 1;
+
+    // Вектор из среза и дозапись срезом
+    Vector<int> copy(big.First(100));
+    assert(copy.Size() == 100 && copy[99] == 99);
+    copy.AppendRange(big.Subspan(100, 50));
+    assert(copy.Size() == 150 && copy[149] == 149);
+
+#ifdef __cpp_lib_span
+    // Конверсия в std::span для стандартных интерфейсов
+    std::span<const int> std_view = big.AsSpan();
+    assert(std_view.size() == big.Size() && std_view.data() == big.begin());
+#endif
+}
+
+void Test32() {
+    // DestroyAsync мгновенно опустошает вектор, деструкторы бегут в фоне
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v;
+        v.Resize(50000);
+        assert(Obj::GetAliveObjectCount() == 50000);
+        v.DestroyAsync();
+        assert(v.Size() == 0 && v.Capacity() == 0);
+
+        // Вектор сразу пригоден к повторному использованию; элементы не
+        // конструируем — счётчики Obj не атомарны, а жнец ещё работает
+        v.Reserve(10);
+        assert(v.Capacity() >= 10);
+    }
+    VectorReaper::Instance().WaitIdle();
+    assert(Obj::GetAliveObjectCount() == 0);
+
+    // Встроенный буфер разрушается синхронно — фону там нечего делать
+    Obj::ResetCounters();
+    Vector<Obj, 8> small;
+    small.EmplaceBack();
+    small.EmplaceBack();
+    small.DestroyAsync();
+    assert(small.Size() == 0 && Obj::GetAliveObjectCount() == 0);
+
+    // Несколько отложенных разрушений разбираются одним жнецом
+    for (int round = 0; round < 4; ++round) {
+        Vector<int> big;
+        big.Resize(100000);
+        big.DestroyAsync();
+    }
+    VectorReaper::Instance().WaitIdle();
+}
+
+void Test33() {
+#ifdef VECTOR_DEBUG_ITERATORS
+    // Итератор, переживший реаллокацию, помечается протухшим
+    Vector<int> v;
+    v.Reserve(4);
+    v.PushBack(1);
+    auto it = v.begin();
+    assert(it.IsValid() && *it == 1);
+    while (v.Size() < v.Capacity()) {
+        v.PushBack(0);
+    }
+    assert(it.IsValid());  // рост в пределах ёмкости буфер не менял
+    v.PushBack(2);         // регров
+    assert(!it.IsValid());
+    assert(v.begin().IsValid());
+
+    // Reserve и Swap тоже старят итераторы
+    auto it2 = v.begin();
+    v.Reserve(v.Capacity() * 2);
+    assert(!it2.IsValid());
+    Vector<int> other;
+    other.PushBack(7);
+    auto it3 = v.begin();
+    auto it4 = other.begin();
+    v.Swap(other);
+    assert(!it3.IsValid() && !it4.IsValid());
+
+    // Обычная итерация и алгоритмы работают как прежде
+    int sum = 0;
+    for (int x : other) {
+        sum += x;
+    }
+    assert(sum > 0);
+    assert(std::count(v.begin(), v.end(), 7) == 1);
+#else
+    // В release-сборке итераторы — в точности голые указатели
+    static_assert(std::is_same_v<Vector<int>::iterator, int*>);
+    static_assert(std::is_same_v<Vector<int>::const_iterator, const int*>);
+#endif
+}
+
+void Test34() {
+    // FlatSet: сортировка поддерживается при вставках, дубликаты отвергаются
+    FlatSet<int> set;
+    for (int x : {5, 1, 9, 3, 7, 3, 5}) {
+        set.Insert(x);
+    }
+    assert(set.Size() == 5);
+    assert(std::is_sorted(set.begin(), set.end()));
+    assert(set.Contains(7) && !set.Contains(4));
+    assert(set.Insert(9).second == false);
+    assert(set.Erase(5) == 1 && set.Erase(5) == 0);
+    assert(set.Size() == 4);
+
+    // Rebuild: массив с дубликатами — одна аллокация, сортировка, дедупликация
+    const int raw[] = {4, 2, 4, 8, 2, 6, 8, 8};
+    set.Rebuild(std::begin(raw), std::end(raw));
+    assert(set.Size() == 4);
+    assert(*set.begin() == 2 && *(set.end() - 1) == 8);
+    assert(set.Underlying().Capacity() == std::size(raw));  // точная аллокация
+
+    // Диапазонное удаление — один сдвиг хвоста
+    set.Erase(set.begin() + 1, set.begin() + 3);
+    assert(set.Size() == 2 && set.Contains(2) && set.Contains(8));
+
+    // FlatMap: lower_bound-поиск, operator[] и InsertOrAssign
+    FlatMap<std::string, int> ages;
+    ages["bob"] = 30;
+    ages["alice"] = 25;
+    ages["carol"] = 35;
+    assert(ages.Size() == 3);
+    assert(ages.begin()->first == "alice");  // обход в порядке ключей
+    assert(ages.At("bob") == 30);
+    ages["bob"] += 1;
+    assert(ages.At("bob") == 31);
+    assert(ages.InsertOrAssign("carol", 36).second == false);
+    assert(ages.At("carol") == 36);
+    assert(ages.Insert({"bob", 99}).second == false && ages.At("bob") == 31);
+    assert(!ages.Contains("dave"));
+    assert(ages.Erase("alice") == 1 && ages.Size() == 2);
+
+    // Rebuild: из записей с равными ключами выживает первая
+    std::vector<std::pair<std::string, int>> dump = {
+        {"y", 2}, {"x", 1}, {"y", 20}, {"z", 3}, {"x", 10},
+    };
+    FlatMap<std::string, int> rebuilt(dump.begin(), dump.end());
+    assert(rebuilt.Size() == 3);
+    assert(rebuilt.At("x") == 1 && rebuilt.At("y") == 2 && rebuilt.At("z") == 3);
+}
+
 void Benchmark() {
     using namespace std;
     try {
@@ -647,6 +2091,34 @@ int main() {
         Test4();
         Test5();
         Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
         Benchmark();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
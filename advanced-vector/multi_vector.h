@@ -0,0 +1,256 @@
+#pragma once
+#include "vector.h"
+#include "span.h"
+
+#include <array>
+#include <tuple>
+
+// Structure-of-arrays поверх одного блока памяти: каждая компонента лежит
+// своей непрерывной «дорожкой» внутри единственной аллокации, начало дорожки
+// выровнено под её тип. Рост — одна аллокация и один проход переноса на все
+// дорожки вместо аллокации и переноса на каждый параллельный вектор; локальность
+// для циклов по двум-трём полям заметно лучше, а раскладка — ровно та, что
+// нужна SIMD-ядрам.
+//
+// MultiVector<float, float, int32_t> book;
+// book.PushBack(px, qty, id);
+// for (float& x : book.Lane<0>()) { ... }
+template <typename... Ts>
+class MultiVector {
+    static constexpr size_t NUM_LANES = sizeof...(Ts);
+    static_assert(NUM_LANES > 0, "MultiVector requires at least one lane");
+    // Блок приходит из обычного operator new и выровнен лишь на
+    // __STDCPP_DEFAULT_NEW_ALIGNMENT__; более строгой дорожке смещение
+    // внутри блока выравнивания не даст
+    static_assert(((alignof(Ts) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) && ...),
+                  "lane alignment must not exceed the default operator new alignment");
+
+public:
+    template <size_t I>
+    using LaneType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    MultiVector() = default;
+
+    MultiVector(const MultiVector&) = delete;
+    MultiVector& operator=(const MultiVector&) = delete;
+
+    MultiVector(MultiVector&& other) noexcept :
+        data_(std::move(other.data_)),
+        offsets_(std::exchange(other.offsets_, {})),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    MultiVector& operator=(MultiVector&& rhs) noexcept {
+        if (&rhs != this) {
+            DestroyAll();
+            data_ = std::move(rhs.data_);
+            offsets_ = std::exchange(rhs.offsets_, {});
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~MultiVector() {
+        DestroyAll();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+
+        RawMemory<std::byte> new_data(BytesFor(new_capacity));
+        const auto new_offsets = Offsets(new_capacity);
+        RelocateLanes(new_data.GetAddress(), new_offsets, std::index_sequence_for<Ts...>{});
+
+        data_.Swap(new_data);
+        offsets_ = new_offsets;
+        capacity_ = new_capacity;
+    }
+
+    // Добавляет запись — по одному значению на дорожку
+    void PushBack(const Ts&... values) {
+        EnsureRoom();
+        ConstructBack(std::index_sequence_for<Ts...>{}, values...);
+        ++size_;
+    }
+
+    void PushBack(Ts&&... values) {
+        EnsureRoom();
+        ConstructBack(std::index_sequence_for<Ts...>{}, std::move(values)...);
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        DestroyBack(std::index_sequence_for<Ts...>{});
+    }
+
+    // Непрерывная дорожка компоненты I
+    template <size_t I>
+    Span<LaneType<I>> Lane() noexcept {
+        return {LanePtr<I>(), size_};
+    }
+
+    template <size_t I>
+    Span<const LaneType<I>> Lane() const noexcept {
+        return {const_cast<MultiVector&>(*this).LanePtr<I>(), size_};
+    }
+
+    // Компонента I записи index
+    template <size_t I>
+    LaneType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return LanePtr<I>()[index];
+    }
+
+    template <size_t I>
+    const LaneType<I>& Get(size_t index) const noexcept {
+        return const_cast<MultiVector&>(*this).Get<I>(index);
+    }
+
+private:
+    static constexpr size_t AlignUp(size_t n, size_t alignment) noexcept {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Смещения дорожек в блоке для заданной ёмкости
+    static std::array<size_t, NUM_LANES> Offsets(size_t capacity) noexcept {
+        std::array<size_t, NUM_LANES> offsets{};
+        size_t offset = 0;
+        size_t lane = 0;
+        auto place = [&](size_t alignment, size_t element_size) {
+            offset = AlignUp(offset, alignment);
+            offsets[lane++] = offset;
+            offset += capacity * element_size;
+        };
+        (place(alignof(Ts), sizeof(Ts)), ...);
+        return offsets;
+    }
+
+    static size_t BytesFor(size_t capacity) noexcept {
+        size_t offset = 0;
+        auto place = [&](size_t alignment, size_t element_size) {
+            offset = AlignUp(offset, alignment);
+            offset += capacity * element_size;
+        };
+        (place(alignof(Ts), sizeof(Ts)), ...);
+        return offset;
+    }
+
+    template <size_t I>
+    LaneType<I>* LanePtr() noexcept {
+        return reinterpret_cast<LaneType<I>*>(data_.GetAddress() + offsets_[I]);
+    }
+
+    void EnsureRoom() {
+        if (size_ == capacity_) {
+            Reserve(DoublingGrowth::Next(capacity_, size_ + 1));
+        }
+    }
+
+    template <size_t... Is, typename... Us>
+    void ConstructBack(std::index_sequence<Is...>, Us&&... values) {
+        (new (LanePtr<Is>() + size_) LaneType<Is>(std::forward<Us>(values)), ...);
+    }
+
+    // Перенос дорожки может бросить — только копированием
+    template <typename U>
+    static constexpr bool LANE_CAN_THROW = !IsTriviallyRelocatableV<U>
+        && !std::is_nothrow_move_constructible_v<U>
+        && std::is_copy_constructible_v<U>;
+
+    static constexpr bool ANY_LANE_CAN_THROW = (LANE_CAN_THROW<Ts> || ...);
+
+    // Конструирует дорожку в новом блоке, не трогая источник: memcpy для
+    // тривиально перемещаемых, иначе перемещение или копирование. Если хоть
+    // одна дорожка может бросить, копируются все копируемые дорожки: источник
+    // обязан пережить откат нетронутым, а перемещение бы его выпотрошило.
+    // Источники завершают жизнь отдельным шагом — после переноса ВСЕХ дорожек
+    template <size_t I>
+    void ConstructLane(std::byte* dst_bytes) {
+        using U = LaneType<I>;
+        U* src = LanePtr<I>();
+        U* dst = reinterpret_cast<U*>(dst_bytes);
+        if constexpr (IsTriviallyRelocatableV<U>) {
+            if (size_ != 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                            size_ * sizeof(U));
+            }
+        } else if constexpr (!std::is_copy_constructible_v<U>
+                             || (std::is_nothrow_move_constructible_v<U> && !ANY_LANE_CAN_THROW)) {
+            std::uninitialized_move_n(src, size_, dst);
+        } else {
+            std::uninitialized_copy_n(src, size_, dst);
+        }
+    }
+
+    // Разрушает копию дорожки в новом блоке при откате. memcpy-дорожки не
+    // трогаем: каноничной для них остаётся копия в источнике
+    template <size_t I>
+    void DestroyDstLane(std::byte* dst_bytes) noexcept {
+        using U = LaneType<I>;
+        if constexpr (!IsTriviallyRelocatableV<U>) {
+            std::destroy_n(reinterpret_cast<U*>(dst_bytes), size_);
+        } else {
+            (void)dst_bytes;
+        }
+    }
+
+    // Завершает жизнь источника дорожки после удачного переноса; для
+    // memcpy-дорожек перенос и был завершением — байты источника мертвы
+    template <size_t I>
+    void DestroySrcLane() noexcept {
+        using U = LaneType<I>;
+        if constexpr (!IsTriviallyRelocatableV<U>) {
+            std::destroy_n(LanePtr<I>(), size_);
+        }
+    }
+
+    template <size_t... Is>
+    void RelocateLanes(std::byte* dst_base, const std::array<size_t, NUM_LANES>& dst_offsets,
+                       std::index_sequence<Is...>) {
+        size_t done = 0;
+        try {
+            ((ConstructLane<Is>(dst_base + dst_offsets[Is]), ++done), ...);
+        } catch (...) {
+            // Источники не тронуты — разрушаем только то, что успели
+            // сконструировать в новом блоке, и отдаём исключение дальше
+            ((Is < done ? DestroyDstLane<Is>(dst_base + dst_offsets[Is]) : void()), ...);
+            throw;
+        }
+        (DestroySrcLane<Is>(), ...);
+    }
+
+    template <size_t... Is>
+    void DestroyBack(std::index_sequence<Is...>) noexcept {
+        (std::destroy_at(LanePtr<Is>() + size_), ...);
+    }
+
+    template <size_t... Is>
+    void DestroyLanes(std::index_sequence<Is...>) noexcept {
+        (std::destroy_n(LanePtr<Is>(), size_), ...);
+    }
+
+    void DestroyAll() noexcept {
+        if (capacity_ != 0) {
+            DestroyLanes(std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    RawMemory<std::byte> data_;
+    std::array<size_t, NUM_LANES> offsets_{};
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,180 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#ifdef __unix__
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// Бинарная (де)сериализация вектора: небольшой заголовок плюс один bulk-вывод
+// непрерывного буфера. Для тривиально копируемых типов запись — ровно два
+// write (или один writev в варианте с файловым дескриптором), чтение идёт
+// прямо в неинициализированный буфер без промежуточных копий. Для остальных
+// типов передаётся поэлементный кодек, но кадрирование остаётся общим.
+//
+// Формат не переносим между платформами с разным порядком байтов или
+// представлением T — это формат снапшотов и IPC, а не обмена
+
+struct VectorIoHeader {
+    uint64_t magic;
+    uint64_t element_size;  // 0 — формат элементов задаёт кодек
+    uint64_t count;
+};
+
+inline constexpr uint64_t VECTOR_IO_MAGIC = 0x524F544345564441;  // "ADVECTOR"
+
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth>
+void WriteTo(const Vector<T, InlineCapacity, Alloc, Growth>& v, std::ostream& out) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WriteTo without a codec requires a trivially copyable type");
+    const VectorIoHeader header{VECTOR_IO_MAGIC, sizeof(T), v.Size()};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (v.Size() != 0) {
+        out.write(reinterpret_cast<const char*>(v.AsSpan().Data()),
+                  static_cast<std::streamsize>(v.Size() * sizeof(T)));
+    }
+    if (!out) {
+        throw std::runtime_error("WriteTo: stream write failed");
+    }
+}
+
+// Кодек вызывается как codec(out, element) для каждого элемента
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth, typename Codec>
+void WriteTo(const Vector<T, InlineCapacity, Alloc, Growth>& v, std::ostream& out, Codec codec) {
+    const VectorIoHeader header{VECTOR_IO_MAGIC, 0, v.Size()};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const T& value : v) {
+        codec(out, value);
+    }
+    if (!out) {
+        throw std::runtime_error("WriteTo: stream write failed");
+    }
+}
+
+inline VectorIoHeader ReadVectorIoHeader(std::istream& in, uint64_t expected_element_size) {
+    VectorIoHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != VECTOR_IO_MAGIC || header.element_size != expected_element_size) {
+        throw std::runtime_error("ReadFrom: bad header");
+    }
+    return header;
+}
+
+template <typename T, size_t InlineCapacity = 0, typename Alloc = NewDeleteAllocator<T>,
+          typename Growth = DoublingGrowth,
+          // Отсекает перегрузку с кодеком: второй аргумент обязан быть аллокатором
+          typename = std::void_t<decltype(std::declval<Alloc&>().Allocate(size_t{}))>>
+Vector<T, InlineCapacity, Alloc, Growth> ReadFrom(std::istream& in, Alloc alloc = Alloc{}) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ReadFrom without a codec requires a trivially copyable type");
+    const VectorIoHeader header = ReadVectorIoHeader(in, sizeof(T));
+
+    Vector<T, InlineCapacity, Alloc, Growth> v(std::move(alloc));
+    v.ResizeForOverwrite(header.count);
+    if (header.count != 0) {
+        in.read(reinterpret_cast<char*>(v.AsSpan().Data()),
+                static_cast<std::streamsize>(header.count * sizeof(T)));
+    }
+    if (!in) {
+        throw std::runtime_error("ReadFrom: truncated stream");
+    }
+    return v;
+}
+
+// Кодек вызывается как codec(in) и возвращает очередной элемент
+template <typename T, size_t InlineCapacity = 0, typename Alloc = NewDeleteAllocator<T>,
+          typename Growth = DoublingGrowth, typename Codec,
+          typename = std::enable_if_t<std::is_invocable_v<Codec&, std::istream&>>>
+Vector<T, InlineCapacity, Alloc, Growth> ReadFrom(std::istream& in, Codec codec,
+                                                  Alloc alloc = Alloc{}) {
+    const VectorIoHeader header = ReadVectorIoHeader(in, 0);
+
+    Vector<T, InlineCapacity, Alloc, Growth> v(std::move(alloc));
+    v.Reserve(header.count);
+    for (uint64_t i = 0; i < header.count; ++i) {
+        v.PushBack(codec(in));
+    }
+    if (!in) {
+        throw std::runtime_error("ReadFrom: truncated stream");
+    }
+    return v;
+}
+
+#ifdef __unix__
+
+// Вариант для файлового дескриптора: заголовок и буфер уходят одним writev.
+// Короткая запись — норма для сокетов и больших пайпов, поэтому дописываем
+// остаток в цикле, как ReadFrom ниже дочитывает остаток read
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth>
+void WriteTo(const Vector<T, InlineCapacity, Alloc, Growth>& v, int fd) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WriteTo without a codec requires a trivially copyable type");
+    const VectorIoHeader header{VECTOR_IO_MAGIC, sizeof(T), v.Size()};
+    iovec parts[2] = {
+        {const_cast<VectorIoHeader*>(&header), sizeof(header)},
+        {const_cast<T*>(v.AsSpan().Data()), v.Size() * sizeof(T)},
+    };
+    iovec* iov = parts;
+    int iov_count = v.Size() != 0 ? 2 : 1;
+    while (iov_count != 0) {
+        ssize_t written = ::writev(fd, iov, iov_count);
+        if (written <= 0) {
+            throw std::runtime_error("WriteTo: writev failed");
+        }
+        // Сдвигаем iovec на записанное: полностью ушедшие отбрасываем,
+        // частично ушедший укорачиваем спереди
+        while (iov_count != 0 && static_cast<size_t>(written) >= iov->iov_len) {
+            written -= iov->iov_len;
+            ++iov;
+            --iov_count;
+        }
+        if (iov_count != 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= static_cast<size_t>(written);
+        }
+    }
+}
+
+template <typename T, size_t InlineCapacity = 0, typename Alloc = NewDeleteAllocator<T>,
+          typename Growth = DoublingGrowth>
+Vector<T, InlineCapacity, Alloc, Growth> ReadFrom(int fd, Alloc alloc = Alloc{}) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ReadFrom without a codec requires a trivially copyable type");
+    // Заголовок тоже дочитываем в цикле: read из сокета или пайпа может
+    // вернуть меньше 24 байт и без всякой ошибки
+    VectorIoHeader header{};
+    char* header_dst = reinterpret_cast<char*>(&header);
+    size_t header_left = sizeof(header);
+    while (header_left != 0) {
+        const ssize_t got = ::read(fd, header_dst, header_left);
+        if (got <= 0) {
+            throw std::runtime_error("ReadFrom: bad header");
+        }
+        header_dst += got;
+        header_left -= static_cast<size_t>(got);
+    }
+    if (header.magic != VECTOR_IO_MAGIC || header.element_size != sizeof(T)) {
+        throw std::runtime_error("ReadFrom: bad header");
+    }
+
+    Vector<T, InlineCapacity, Alloc, Growth> v(std::move(alloc));
+    v.ResizeForOverwrite(header.count);
+    size_t bytes_left = header.count * sizeof(T);
+    char* dst = reinterpret_cast<char*>(v.AsSpan().Data());
+    while (bytes_left != 0) {
+        const ssize_t got = ::read(fd, dst, bytes_left);
+        if (got <= 0) {
+            throw std::runtime_error("ReadFrom: truncated input");
+        }
+        dst += got;
+        bytes_left -= static_cast<size_t>(got);
+    }
+    return v;
+}
+
+#endif  // __unix__
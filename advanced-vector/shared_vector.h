@@ -0,0 +1,156 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Copy-on-write обёртка над Vector для read-mostly разделяемых данных
+// (конфиги, таблицы символов): копия — это инкремент атомарного счётчика,
+// а не аллокация с переносом. Физическое копирование случается только в
+// мутирующем методе и только если буфер в этот момент разделён.
+//
+// Семантика значений снаружи сохранена: после любой мутации другие копии
+// видят прежнее содержимое. Читать одну и ту же копию из многих потоков
+// можно без синхронизации; мутировать конкретный SharedVector — только из
+// одного потока, как и обычный Vector
+template <typename T, typename Alloc = NewDeleteAllocator<T>, typename Growth = DoublingGrowth>
+class SharedVector {
+public:
+    using VectorType = Vector<T, 0, Alloc, Growth>;
+    using iterator = typename VectorType::const_iterator;
+    using const_iterator = typename VectorType::const_iterator;
+
+    SharedVector() :
+        shared_(new Shared{}) {
+    }
+
+    explicit SharedVector(VectorType v) :
+        shared_(new Shared{std::move(v), {1}}) {
+    }
+
+    SharedVector(const SharedVector& other) noexcept :
+        shared_(other.shared_) {
+        shared_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedVector& operator=(const SharedVector& rhs) noexcept {
+        if (&rhs != this) {
+            rhs.shared_->refs.fetch_add(1, std::memory_order_relaxed);
+            Unref();
+            shared_ = rhs.shared_;
+        }
+        return *this;
+    }
+
+    SharedVector(SharedVector&& other) noexcept :
+        shared_(std::exchange(other.shared_, nullptr)) {
+    }
+
+    SharedVector& operator=(SharedVector&& rhs) noexcept {
+        if (&rhs != this) {
+            Unref();
+            shared_ = std::exchange(rhs.shared_, nullptr);
+        }
+        return *this;
+    }
+
+    ~SharedVector() {
+        Unref();
+    }
+
+    // --- Читающий API: никогда не копирует ---
+
+    size_t Size() const noexcept {
+        return shared_->v.Size();
+    }
+
+    size_t Capacity() const noexcept {
+        return shared_->v.Capacity();
+    }
+
+    const_iterator begin() const noexcept {
+        return shared_->v.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return shared_->v.end();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return shared_->v[index];
+    }
+
+    const VectorType& Get() const noexcept {
+        return shared_->v;
+    }
+
+    // Сколько копий делят буфер; для диагностики и тестов
+    size_t UseCount() const noexcept {
+        return shared_->refs.load(std::memory_order_relaxed);
+    }
+
+    // --- Мутирующий API: отцепляется от разделённого буфера ---
+
+    template <typename Ref>
+    void PushBack(Ref&& value) {
+        Detach().PushBack(std::forward<Ref>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return Detach().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PopBack() {
+        Detach().PopBack();
+    }
+
+    void Resize(size_t new_size) {
+        Detach().Resize(new_size);
+    }
+
+    void Reserve(size_t new_capacity) {
+        Detach().Reserve(new_capacity);
+    }
+
+    void Erase(size_t index) {
+        VectorType& v = Detach();
+        v.Erase(v.begin() + index);
+    }
+
+    // Неконстантный доступ к элементу — тоже мутация: ссылку могут записать
+    T& operator[](size_t index) {
+        return Detach()[index];
+    }
+
+    // Полный доступ к уникальной копии для операций, которых нет в обёртке
+    VectorType& Mutable() {
+        return Detach();
+    }
+
+private:
+    struct Shared {
+        VectorType v;
+        std::atomic<size_t> refs{1};
+    };
+
+    // Гарантирует единоличное владение буфером: если он разделён, текущая
+    // копия пересаживается на собственный клон. После возврата гонок за
+    // буфер нет — остальные владельцы держат старый Shared
+    VectorType& Detach() {
+        if (shared_->refs.load(std::memory_order_acquire) != 1) {
+            Shared* own = new Shared{shared_->v, {1}};
+            Unref();
+            shared_ = own;
+        }
+        return shared_->v;
+    }
+
+    void Unref() noexcept {
+        if (shared_ != nullptr
+            && shared_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared_;
+        }
+    }
+
+    Shared* shared_ = nullptr;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+// Невладеющее представление непрерывного участка памяти — лёгкий аналог
+// std::span для сборок под C++17. Указатель и длина, никакого владения:
+// время жизни памяти контролирует её хозяин
+template <typename T>
+class Span {
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, size_t size) noexcept :
+        data_(data),
+        size_(size) {
+    }
+
+    // Span<T> неявно сужается до Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    constexpr Span(Span<U> other) noexcept :
+        data_(other.Data()),
+        size_(other.Size()) {
+    }
+
+#ifdef __cpp_lib_span
+    // Интероп со стандартными интерфейсами, принимающими std::span
+    constexpr operator std::span<T>() const noexcept {
+        return {data_, size_};
+    }
+#endif
+
+    constexpr T* begin() const noexcept {
+        return data_;
+    }
+
+    constexpr T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr T* Data() const noexcept {
+        return data_;
+    }
+
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    constexpr T& Front() const noexcept {
+        assert(size_ != 0);
+        return data_[0];
+    }
+
+    constexpr T& Back() const noexcept {
+        assert(size_ != 0);
+        return data_[size_ - 1];
+    }
+
+    constexpr Span First(size_t count) const noexcept {
+        assert(count <= size_);
+        return {data_, count};
+    }
+
+    constexpr Span Last(size_t count) const noexcept {
+        assert(count <= size_);
+        return {data_ + size_ - count, count};
+    }
+
+    constexpr Span Subspan(size_t offset, size_t count) const noexcept {
+        assert(offset <= size_ && count <= size_ - offset);
+        return {data_ + offset, count};
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
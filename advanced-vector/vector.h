@@ -1,130 +1,681 @@
 #pragma once
+#include "span.h"
+
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <type_traits>
 #include <iterator>
+#include <initializer_list>
 #include <new>
 #include <utility>
+#include <functional>
 #include <memory>
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// constexpr-векторы требуют constexpr-аллокаций из C++20; в C++17 всё работает,
+// но только во время выполнения
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define VECTOR_CONSTEXPR20 constexpr
+#define VECTOR_HAS_CONSTEXPR20 1
+#else
+#define VECTOR_CONSTEXPR20
+#define VECTOR_HAS_CONSTEXPR20 0
+#endif
+
+// Отладочные итераторы с проверкой инвалидации — сборка с
+// -DVECTOR_DEBUG_ITERATORS; в обычной сборке итератор остаётся голым T*
+#ifdef VECTOR_DEBUG_ITERATORS
+#define VECTOR_HAS_DEBUG_ITERATORS 1
+#else
+#define VECTOR_HAS_DEBUG_ITERATORS 0
+#endif
+
+// Опт-ин статистика горячих путей: собирается при сборке с -DVECTOR_ENABLE_STATS,
+// иначе все хуки — пустые inline-функции и кода не генерируют. Счётчики
+// потоколокальные, так что горячие пути не дерутся за кэш-линию; Snapshot()
+// возвращает срез по текущему потоку
+struct VectorStats {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes_requested = 0;
+    size_t regrows = 0;
+    size_t elements_relocated = 0;
+    size_t peak_allocation_bytes = 0;
+
+    static VECTOR_CONSTEXPR20 VectorStats Snapshot() noexcept {
+#ifdef VECTOR_ENABLE_STATS
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return {};
+        }
+#endif
+        return Local();
+#else
+        return {};
+#endif
+    }
+
+    static VECTOR_CONSTEXPR20 void Reset() noexcept {
+#ifdef VECTOR_ENABLE_STATS
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        Local() = {};
+#endif
+    }
+
+    static VECTOR_CONSTEXPR20 void OnAllocate([[maybe_unused]] size_t bytes) noexcept {
+#ifdef VECTOR_ENABLE_STATS
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        VectorStats& stats = Local();
+        ++stats.allocations;
+        stats.bytes_requested += bytes;
+        stats.peak_allocation_bytes = std::max(stats.peak_allocation_bytes, bytes);
+#endif
+    }
+
+    static VECTOR_CONSTEXPR20 void OnDeallocate() noexcept {
+#ifdef VECTOR_ENABLE_STATS
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        ++Local().deallocations;
+#endif
+    }
+
+    static VECTOR_CONSTEXPR20 void OnRegrow([[maybe_unused]] size_t relocated) noexcept {
+#ifdef VECTOR_ENABLE_STATS
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        VectorStats& stats = Local();
+        ++stats.regrows;
+        stats.elements_relocated += relocated;
+#endif
+    }
+
+#ifdef VECTOR_ENABLE_STATS
+
+private:
+    static VectorStats& Local() noexcept {
+        thread_local VectorStats stats;
+        return stats;
+    }
+#endif
+};
 
+// Аллокатор по умолчанию: глобальные operator new/operator delete.
+// В константных вычислениях памятью управляет std::allocator
 template <typename T>
-class RawMemory {
+struct NewDeleteAllocator {
+    VECTOR_CONSTEXPR20 T* Allocate(size_t n) {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>{}.allocate(n);
+        }
+#endif
+        return static_cast<T*>(operator new(n * sizeof(T)));
+    }
+
+    // Небросающий вариант для Try*-API: nullptr вместо bad_alloc
+    T* AllocateNoThrow(size_t n) noexcept {
+        return static_cast<T*>(operator new(n * sizeof(T), std::nothrow));
+    }
+
+    VECTOR_CONSTEXPR20 void Deallocate(T* buf, size_t n) noexcept {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            std::allocator<T>{}.deallocate(buf, n);
+            return;
+        }
+#endif
+        (void)n;
+        operator delete(buf);
+    }
+};
+
+// Обнаруживает необязательный метод аллокатора Reallocate(buf, old_n, new_n):
+// рост буфера на месте (например, mremap), nullptr — если не получилось
+template <typename A, typename U, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename A, typename U>
+struct HasReallocate<A, U, std::void_t<decltype(std::declval<A&>().Reallocate(
+    std::declval<U*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename A, typename U>
+inline constexpr bool HasReallocateV = HasReallocate<A, U>::value;
+
+// Аллокатор умеет сообщать о нехватке памяти возвратом nullptr
+template <typename A, typename U, typename = void>
+struct HasAllocateNoThrow : std::false_type {};
+
+template <typename A, typename U>
+struct HasAllocateNoThrow<A, U,
+    std::void_t<decltype(std::declval<A&>().AllocateNoThrow(size_t{}))>>
+    : std::true_type {};
+
+template <typename A, typename U>
+inline constexpr bool HasAllocateNoThrowV = HasAllocateNoThrow<A, U>::value;
+
+// Метка «сообщать о нехватке памяти возвратом, а не исключением»
+struct NoThrowTag {};
+
+// Выравнивание, которое аллокатор обещает базовому адресу буфера; если
+// аллокатор его не объявляет, гарантируется лишь естественное выравнивание
+template <typename A, typename U, typename = void>
+struct AllocAlignment : std::integral_constant<size_t, alignof(U)> {};
+
+template <typename A, typename U>
+struct AllocAlignment<A, U, std::void_t<decltype(A::Alignment)>>
+    : std::integral_constant<size_t, A::Alignment> {};
+
+template <typename T, typename Alloc = NewDeleteAllocator<T>>
+class RawMemory : private Alloc {
 public:
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity) :
+    VECTOR_CONSTEXPR20 explicit RawMemory(size_t capacity, Alloc alloc = Alloc{}) :
+        Alloc(std::move(alloc)),
         buffer_(Allocate(capacity)),
         capacity_(capacity) {
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    // Небросающее выделение: при нехватке памяти буфер остаётся нулевым,
+    // проверяется через GetAddress(). Требует AllocateNoThrow у аллокатора
+    RawMemory(NoThrowTag, size_t capacity, Alloc alloc = Alloc{}) noexcept :
+        Alloc(std::move(alloc)) {
+        static_assert(HasAllocateNoThrowV<Alloc, T>,
+                      "allocator must provide AllocateNoThrow for the Try* API");
+        if (capacity != 0) {
+            buffer_ = static_cast<Alloc&>(*this).AllocateNoThrow(capacity);
+            if (buffer_ != nullptr) {
+                VectorStats::OnAllocate(capacity * sizeof(T));
+                capacity_ = capacity;
+            }
+        }
+    }
+
+    VECTOR_CONSTEXPR20 ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
 
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
-    RawMemory(RawMemory&& other) noexcept :
+    VECTOR_CONSTEXPR20 RawMemory(RawMemory&& other) noexcept :
+        Alloc(std::move(static_cast<Alloc&>(other))),
         buffer_(std::exchange(other.buffer_, nullptr)),
-        capacity_(std::exchange(other.capacity_, 0)) {
+        capacity_(std::exchange(other.capacity_, 0)),
+        deleter_(std::exchange(other.deleter_, nullptr)) {
     }
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
+    VECTOR_CONSTEXPR20 RawMemory& operator=(RawMemory&& rhs) noexcept {
         if (&rhs != this) {
+            // Буферы обмениваются, поэтому и аллокаторы обмениваются:
+            // каждый буфер должен освобождаться своим аллокатором
+            std::swap(static_cast<Alloc&>(*this), static_cast<Alloc&>(rhs));
             buffer_ = std::exchange(rhs.buffer_, buffer_);
             capacity_ = std::exchange(rhs.capacity_, capacity_);
+            deleter_ = std::exchange(rhs.deleter_, deleter_);
         }
         return *this;
     }
 
-    T* operator+(size_t offset) noexcept {
+    VECTOR_CONSTEXPR20 T* operator+(size_t offset) noexcept {
         // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
         assert(offset <= capacity_);
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    VECTOR_CONSTEXPR20 const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR20 const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    VECTOR_CONSTEXPR20 T& operator[](size_t index) noexcept {
         assert(index < capacity_);
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
+    VECTOR_CONSTEXPR20 void Swap(RawMemory& other) noexcept {
+        std::swap(static_cast<Alloc&>(*this), static_cast<Alloc&>(other));
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
+        std::swap(deleter_, other.deleter_);
+    }
+
+    VECTOR_CONSTEXPR20 const Alloc& GetAllocator() const noexcept {
+        return *this;
+    }
+
+    // Принимает чужой буфер: освобождаться он будет переданным deleter,
+    // а не аллокатором. Текущий буфер освобождается
+    void Adopt(T* buf, size_t capacity, void (*deleter)(T*, size_t)) noexcept {
+        Deallocate(buffer_, capacity_);
+        buffer_ = buf;
+        capacity_ = capacity;
+        deleter_ = deleter;
+    }
+
+    // Отдаёт буфер вызывающему вместе с ответственностью за его освобождение
+    T* Release() noexcept {
+        capacity_ = 0;
+        deleter_ = nullptr;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    // Пытается нарастить буфер на месте силами аллокатора; false — если
+    // аллокатор этого не умеет, буфера ещё нет или он принят извне
+    bool TryReallocate(size_t new_capacity) {
+        if constexpr (HasReallocateV<Alloc, T>) {
+            if (buffer_ == nullptr || deleter_ != nullptr) {
+                return false;
+            }
+            T* moved = static_cast<Alloc&>(*this).Reallocate(buffer_, capacity_, new_capacity);
+            if (moved == nullptr) {
+                return false;
+            }
+            buffer_ = moved;
+            capacity_ = new_capacity;
+            return true;
+        } else {
+            (void)new_capacity;
+            return false;
+        }
     }
 
-    const T* GetAddress() const noexcept {
+    VECTOR_CONSTEXPR20 const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    VECTOR_CONSTEXPR20 T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    VECTOR_CONSTEXPR20 size_t Capacity() const {
         return capacity_;
     }
 
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    VECTOR_CONSTEXPR20 T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        VectorStats::OnAllocate(n * sizeof(T));
+        return static_cast<Alloc&>(*this).Allocate(n);
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate,
+    // либо принятую через Adopt — тогда работает её deleter
+    VECTOR_CONSTEXPR20 void Deallocate(T* buf, size_t n) noexcept {
+        if (buf == nullptr) {
+            return;
+        }
+        VectorStats::OnDeallocate();
+        if (deleter_ != nullptr) {
+            std::exchange(deleter_, nullptr)(buf, n);
+            return;
+        }
+        static_cast<Alloc&>(*this).Deallocate(buf, n);
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    // Ненулевой, пока текущий буфер — принятый извне
+    void (*deleter_)(T*, size_t) = nullptr;
+};
+
+// Метка «не инициализировать элементы» для буферов, которые будут перезаписаны целиком
+struct UninitializedTag {};
+
+// Опт-ин параллелизм массового конструирования/разрушения; 0 — по числу ядер
+struct Parallelism {
+    size_t thread_count = 0;
+};
+
+// Политика роста ёмкости: новая ёмкость = max(требуемая, старая * Num / Den)
+template <size_t Num, size_t Den>
+struct RatioGrowth {
+    static constexpr size_t Next(size_t capacity, size_t required) noexcept {
+        return std::max({required, capacity * Num / Den, size_t{1}});
+    }
+};
+
+// Политика по умолчанию — удвоение
+using DoublingGrowth = RatioGrowth<2, 1>;
+
+// Рост строго до требуемого размера — без запаса, но с квадратичной стоимостью
+// серии одиночных PushBack; для капризных к памяти сервисов
+struct ExactGrowth {
+    static constexpr size_t Next(size_t /*capacity*/, size_t required) noexcept {
+        return required;
+    }
 };
 
+// Опт-ин признак тривиальной перемещаемости: memcpy байтов плюс отказ от
+// источника без вызова деструктора эквивалентны перемещению с разрушением.
+// Специализируйте для своих типов (обёртки над указателями, строки и т.п.)
 template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// Хеш непрерывного буфера одним проходом: FNV-1a по 8-байтовым словам
+// с побайтовым хвостом — дешевле поэлементного комбинирования std::hash
+inline size_t HashBytes(const void* data, size_t len) noexcept {
+    constexpr uint64_t PRIME = 1099511628211ull;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = 14695981039346656037ull;
+    while (len >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        h = (h ^ word) * PRIME;
+        p += sizeof(word);
+        len -= sizeof(word);
+    }
+    for (; len != 0; --len) {
+        h = (h ^ *p++) * PRIME;
+    }
+    // Финальное перемешивание: словарный FNV оставляет младшие биты слабыми
+    h ^= h >> 32;
+    return static_cast<size_t>(h);
+}
+
+#if VECTOR_HAS_DEBUG_ITERATORS
+// Итератор с проверкой инвалидации: запоминает поколение буфера владельца
+// на момент создания, и каждый доступ сверяет его с текущим — итератор,
+// переживший реаллокацию, роняет assert вместо порчи памяти. Дешёвая
+// альтернатива ASan для канареечных сборок; в release-сборке вместо него
+// голый T* без единого лишнего байта и сравнения
+template <typename T, typename Owner>
+class CheckedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr CheckedIterator() noexcept = default;
+
+    constexpr CheckedIterator(T* ptr, const Owner* owner, size_t generation) noexcept :
+        ptr_(ptr),
+        owner_(owner),
+        generation_(generation) {
+    }
+
+    // iterator неявно сужается до const_iterator
+    template <typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    constexpr CheckedIterator(CheckedIterator<U, Owner> other) noexcept :
+        ptr_(other.ptr_),
+        owner_(other.owner_),
+        generation_(other.generation_) {
+    }
+
+    // Жив ли итератор: буфер владельца не перевыделялся с момента создания
+    constexpr bool IsValid() const noexcept {
+        return owner_ != nullptr && generation_ == owner_->IteratorGeneration();
+    }
+
+    constexpr reference operator*() const noexcept {
+        assert(IsValid());
+        return *ptr_;
+    }
+
+    constexpr pointer operator->() const noexcept {
+        assert(IsValid());
+        return ptr_;
+    }
+
+    constexpr reference operator[](difference_type n) const noexcept {
+        assert(IsValid());
+        return ptr_[n];
+    }
+
+    // Неявная конверсия в указатель — для memcmp и прочего интеропа;
+    // не проверяется, как и любой голый указатель
+    constexpr operator pointer() const noexcept {
+        return ptr_;
+    }
+
+    constexpr T* Raw() const noexcept {
+        return ptr_;
+    }
+
+    constexpr CheckedIterator& operator++() noexcept {
+        assert(IsValid());
+        ++ptr_;
+        return *this;
+    }
+
+    constexpr CheckedIterator operator++(int) noexcept {
+        CheckedIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    constexpr CheckedIterator& operator--() noexcept {
+        assert(IsValid());
+        --ptr_;
+        return *this;
+    }
+
+    constexpr CheckedIterator operator--(int) noexcept {
+        CheckedIterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    constexpr CheckedIterator& operator+=(difference_type n) noexcept {
+        assert(IsValid());
+        ptr_ += n;
+        return *this;
+    }
+
+    constexpr CheckedIterator& operator-=(difference_type n) noexcept {
+        return *this += -n;
+    }
+
+    constexpr CheckedIterator operator+(difference_type n) const noexcept {
+        CheckedIterator tmp = *this;
+        return tmp += n;
+    }
+
+    constexpr CheckedIterator operator-(difference_type n) const noexcept {
+        CheckedIterator tmp = *this;
+        return tmp -= n;
+    }
+
+    constexpr difference_type operator-(const CheckedIterator& rhs) const noexcept {
+        assert(owner_ == rhs.owner_);
+        return ptr_ - rhs.ptr_;
+    }
+
+    constexpr bool operator==(const CheckedIterator& rhs) const noexcept {
+        return ptr_ == rhs.ptr_;
+    }
+
+    constexpr bool operator!=(const CheckedIterator& rhs) const noexcept {
+        return ptr_ != rhs.ptr_;
+    }
+
+    constexpr bool operator<(const CheckedIterator& rhs) const noexcept {
+        return ptr_ < rhs.ptr_;
+    }
+
+    constexpr bool operator>(const CheckedIterator& rhs) const noexcept {
+        return ptr_ > rhs.ptr_;
+    }
+
+    constexpr bool operator<=(const CheckedIterator& rhs) const noexcept {
+        return ptr_ <= rhs.ptr_;
+    }
+
+    constexpr bool operator>=(const CheckedIterator& rhs) const noexcept {
+        return ptr_ >= rhs.ptr_;
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    T* ptr_ = nullptr;
+    const Owner* owner_ = nullptr;
+    size_t generation_ = 0;
+};
+#endif  // VECTOR_HAS_DEBUG_ITERATORS
+
+// Встроенное хранилище для малых векторов: N элементов живут внутри самого объекта
+template <typename T, size_t N>
+struct InlineStorage {
+    T* Get() noexcept {
+        return reinterpret_cast<T*>(buf_);
+    }
+
+    const T* Get() const noexcept {
+        return reinterpret_cast<const T*>(buf_);
+    }
+
+    alignas(T) std::byte buf_[N * sizeof(T)];
+};
+
+template <typename T>
+struct InlineStorage<T, 0> {
+    constexpr T* Get() noexcept {
+        return nullptr;
+    }
+
+    constexpr const T* Get() const noexcept {
+        return nullptr;
+    }
+};
+
+template <typename T, size_t InlineCapacity = 0, typename Alloc = NewDeleteAllocator<T>,
+          typename Growth = DoublingGrowth>
+class ConcurrentAppender;
+
+template <typename T, size_t InlineCapacity = 0, typename Alloc = NewDeleteAllocator<T>,
+          typename Growth = DoublingGrowth>
 class Vector {
 public:
+#if VECTOR_HAS_DEBUG_ITERATORS
+    using iterator = CheckedIterator<T, Vector>;
+    using const_iterator = CheckedIterator<const T, Vector>;
+#else
     using iterator = T*;
     using const_iterator = const T*;
+#endif
+    using allocator_type = Alloc;
+
+    // Гарантированное выравнивание начала кучевого буфера; ядра могут
+    // ставить на него static_assert и подсказывать его компилятору
+    static constexpr size_t BufferAlignment = AllocAlignment<Alloc, T>::value;
 
     Vector() = default;
 
-    explicit Vector(size_t size) :
-        data_(size),
+    VECTOR_CONSTEXPR20 explicit Vector(Alloc alloc) :
+        data_(0, std::move(alloc)) {
+    }
+
+    VECTOR_CONSTEXPR20 explicit Vector(size_t size, Alloc alloc = Alloc{}) :
+        data_(size <= InlineCapacity ? 0 : size, std::move(alloc)),
         size_(size) {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        ValueConstructN(Data(), size);
     }
 
-    ~Vector() noexcept {
-        std::destroy_n(data_.GetAddress(), size_);
+    // Создаёт вектор заданного размера, конструируя элементы в несколько потоков.
+    // Для типов с бросающим конструктором выполняется последовательно
+    Vector(size_t size, Parallelism par, Alloc alloc = Alloc{}) :
+        data_(size <= InlineCapacity ? 0 : size, std::move(alloc)),
+        size_(size) {
+        ParallelValueConstructN(Data(), size, par);
     }
 
-    Vector(const Vector& other) :
-        data_(other.size_),
+    Vector(const Vector& other, Parallelism par) :
+        data_(other.size_ <= InlineCapacity ? 0 : other.size_, other.data_.GetAllocator()),
         size_(other.size_) {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        ParallelCopyN(other.Data(), other.size_, Data(), par);
+    }
+
+    // Создаёт вектор из диапазона: ёмкость выделяется один раз точно под
+    // размер, элементы заполняются bulk-копированием без проверки ёмкости
+    // на каждом шаге
+    template <typename FwdIt, typename = std::enable_if_t<!std::is_integral_v<FwdIt>>>
+    Vector(FwdIt first, FwdIt last, Alloc alloc = Alloc{}) :
+        Vector(std::move(alloc)) {
+        AppendRange(first, last);
+    }
+
+    // Материализует срез во владеющий вектор; явная, потому что копирует
+    explicit Vector(Span<const T> values, Alloc alloc = Alloc{}) :
+        Vector(values.begin(), values.end(), std::move(alloc)) {
+    }
+
+    Vector(std::initializer_list<T> values, Alloc alloc = Alloc{}) :
+        Vector(values.begin(), values.end(), std::move(alloc)) {
+    }
+
+    // Создаёт вектор из size копий value
+    Vector(size_t size, const T& value, Alloc alloc = Alloc{}) :
+        Vector(std::move(alloc)) {
+        Reserve(size);
+        std::uninitialized_fill_n(Data(), size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор заданного размера, не инициализируя элементы:
+    // зануление перед полной перезаписью — пустая трата полосы памяти
+    Vector(size_t size, UninitializedTag, Alloc alloc = Alloc{}) :
+        data_(size <= InlineCapacity ? 0 : size, std::move(alloc)),
+        size_(size) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "UninitializedTag requires a trivially default-constructible type");
+    }
+
+    VECTOR_CONSTEXPR20 ~Vector() noexcept {
+        std::destroy_n(Data(), size_);
+    }
+
+    VECTOR_CONSTEXPR20 Vector(const Vector& other) :
+        data_(other.size_ <= InlineCapacity ? 0 : other.size_, other.data_.GetAllocator()),
+        size_(other.size_) {
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
     }
 
     Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
-            if (rhs.size_ > data_.Capacity()) {
+            if (rhs.size_ > Capacity()) {
                 auto rhs_copy(rhs);
                 Swap(rhs_copy);
             } else {
                 if (size_ > rhs.size_) {
-                    std::copy_n(rhs.data_.GetAddress(), rhs.size_, data_.GetAddress());
-                    std::destroy_n(data_ + rhs.size_, size_ - rhs.size_);
+                    std::copy_n(rhs.Data(), rhs.size_, Data());
+                    std::destroy_n(Data() + rhs.size_, size_ - rhs.size_);
                 } else {
-                    std::copy_n(rhs.data_.GetAddress(), size_, data_.GetAddress());
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress());
+                    std::copy_n(rhs.Data(), size_, Data());
+                    std::uninitialized_copy_n(rhs.Data() + size_, rhs.size_ - size_, Data() + size_);
                 }
                 size_ = rhs.size_;
             }
@@ -132,75 +683,158 @@ public:
         return *this;
     }
 
-    Vector(Vector&& other) noexcept :
-        data_(std::move(other.data_)),
-        size_(std::exchange(other.size_, 0)) {
+    VECTOR_CONSTEXPR20 Vector(Vector&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) :
+        data_(0, other.data_.GetAllocator()),
+        size_(other.size_) {
+        if (other.IsInline()) {
+            // Встроенный буфер нельзя украсть обменом указателей — переносим поэлементно
+            RelocateN(other.Data(), size_, inline_.Get());
+        } else {
+            data_ = std::move(other.data_);
+        }
+        other.size_ = 0;
+        other.OnBufferChange();
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    VECTOR_CONSTEXPR20 Vector& operator=(Vector&& rhs) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
         if (this != &rhs) {
-            Swap(rhs);
+            if (rhs.IsInline()) {
+                // Ёмкость всегда не меньше InlineCapacity, места хватит.
+                // size_ обнуляем до переноса: если копия бросит, старые
+                // элементы уже уничтожены и вторично разрушаться не должны
+                std::destroy_n(Data(), size_);
+                size_ = 0;
+                RelocateN(rhs.Data(), rhs.size_, Data());
+                size_ = std::exchange(rhs.size_, 0);
+            } else {
+                std::destroy_n(Data(), size_);
+                data_ = std::move(rhs.data_);
+                size_ = std::exchange(rhs.size_, 0);
+            }
+            OnBufferChange();
+            rhs.OnBufferChange();
         }
         return *this;
     }
 
-    iterator begin() noexcept {
-        return data_.GetAddress();
+    VECTOR_CONSTEXPR20 iterator begin() noexcept {
+        return MakeIterator(Data());
     }
 
-    iterator end() noexcept {
-        return data_ + size_;
+    VECTOR_CONSTEXPR20 iterator end() noexcept {
+        return MakeIterator(Data() + size_);
     }
 
-    const_iterator begin() const noexcept {
+    VECTOR_CONSTEXPR20 const_iterator begin() const noexcept {
         return cbegin();
     }
 
-    const_iterator end() const noexcept {
+    VECTOR_CONSTEXPR20 const_iterator end() const noexcept {
         return cend();
     }
 
-    const_iterator cbegin() const noexcept {
-        return data_.GetAddress();
+    VECTOR_CONSTEXPR20 const_iterator cbegin() const noexcept {
+        return MakeIterator(Data());
+    }
+
+    VECTOR_CONSTEXPR20 const_iterator cend() const noexcept {
+        return MakeIterator(Data() + size_);
+    }
+
+    // Невладеющие срезы поверх буфера: раздать куски вектора воркерам
+    // без копирования. Срез живёт, пока вектор не перевыделит буфер
+    Span<T> AsSpan() noexcept {
+        return {Data(), size_};
+    }
+
+    Span<const T> AsSpan() const noexcept {
+        return {Data(), size_};
+    }
+
+    Span<T> Subspan(size_t offset, size_t count) noexcept {
+        return AsSpan().Subspan(offset, count);
     }
 
-    const_iterator cend() const noexcept {
-        return data_ + size_;
+    Span<const T> Subspan(size_t offset, size_t count) const noexcept {
+        return AsSpan().Subspan(offset, count);
     }
 
-    size_t Size() const noexcept {
+    Span<T> First(size_t count) noexcept {
+        return AsSpan().First(count);
+    }
+
+    Span<const T> First(size_t count) const noexcept {
+        return AsSpan().First(count);
+    }
+
+    Span<T> Last(size_t count) noexcept {
+        return AsSpan().Last(count);
+    }
+
+    Span<const T> Last(size_t count) const noexcept {
+        return AsSpan().Last(count);
+    }
+
+    VECTOR_CONSTEXPR20 size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
-        return data_.Capacity();
+    VECTOR_CONSTEXPR20 size_t Capacity() const noexcept {
+        return IsInline() ? InlineCapacity : data_.Capacity();
+    }
+
+    VECTOR_CONSTEXPR20 const Alloc& GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+#if VECTOR_HAS_DEBUG_ITERATORS
+    // Текущее поколение буфера; растёт при каждой реаллокации
+    size_t IteratorGeneration() const noexcept {
+        return generation_;
+    }
+#endif
+
+    // Хеш содержимого. Для типов, у которых значение однозначно задаётся
+    // байтовым представлением, — один проход HashBytes по буферу; иначе
+    // поэлементное комбинирование через std::hash
+    size_t Hash() const {
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            return HashBytes(Data(), size_ * sizeof(T));
+        } else {
+            size_t h = size_;
+            for (const T& value : *this) {
+                h = (h ^ std::hash<T>{}(value)) * 1099511628211ull;
+            }
+            return h;
+        }
     }
 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR20 const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    VECTOR_CONSTEXPR20 T& operator[](size_t index) noexcept {
         assert(index < size_);
-        return data_[index];
+        return Data()[index];
     }
 
     template<typename Ref>
-    void PushBack(Ref&& value) {
+    VECTOR_CONSTEXPR20 void PushBack(Ref&& value) {
         EmplaceBack(std::forward<Ref>(value));
     }
 
     template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
+    VECTOR_CONSTEXPR20 T& EmplaceBack(Args&&... args) {
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            new (new_data + size_) T(std::forward<Args>(args)...);
+            RawMemory<T, Alloc> new_data(Growth::Next(Capacity(), size_ + 1), data_.GetAllocator());
+            ConstructAt(new_data + size_, std::forward<Args>(args)...);
 
-            CopyN(data_.GetAddress(), size_, new_data.GetAddress());
-            std::destroy_n(data_.GetAddress(), size_);
+            RelocateN(Data(), size_, new_data.GetAddress());
+            VectorStats::OnRegrow(size_);
             data_.Swap(new_data);
+            OnBufferChange();
         } else {
-            new (data_ + size_) T(std::forward<Args>(args)...);
+            ConstructAt(Data() + size_, std::forward<Args>(args)...);
         }
 
         ++size_;
@@ -208,96 +842,841 @@ public:
         return (*this)[size_ - 1];
     }
 
-    void PopBack() noexcept {
-        data_[--size_].~T();
+    // Отцепляет элементы вместе с буфером и разрушает их в фоновом
+    // потоке-жнеце; сам вектор сразу пуст, вызывающий поток не платит за
+    // деструкторы. Встроенный буфер разрушается на месте — он мал по
+    // построению. Определение — после VectorReaper
+    void DestroyAsync();
+
+    VECTOR_CONSTEXPR20 void PopBack() noexcept {
+        Data()[--size_].~T();
     }
 
     template <typename... Args>
     iterator Emplace(const_iterator pos, Args&&... args) {
-        size_t distance = pos - data_.GetAddress();
+        size_t distance = static_cast<size_t>(Unwrap(pos) - Data());
 
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+            RawMemory<T, Alloc> new_data(Growth::Next(Capacity(), size_ + 1), data_.GetAllocator());
             auto* tmp = new (new_data + distance) T(std::forward<Args>(args)...);
 
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                RelocateN(Data(), distance, new_data.GetAddress());
+                RelocateN(Data() + distance, size_ - distance, new_data.GetAddress() + distance + 1);
+            } else {
+                try {
+                    CopyN(Data(), distance, new_data.GetAddress());
+                } catch(...) {
+                    tmp->~T();
+                    throw;
+                }
+
+                try {
+                    CopyN(Data() + distance, size_ - distance, new_data.GetAddress() + distance + 1);
+                } catch(...) {
+                    std::destroy_n(new_data.GetAddress(), distance + 1);
+                    throw;
+                }
+
+                std::destroy_n(Data(), size_);
+            }
+            VectorStats::OnRegrow(size_);
+            data_.Swap(new_data);
+            OnBufferChange();
+        } else {
+            if (distance < size_) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    // Сначала конструируем значение: аргументы могут ссылаться на сдвигаемые элементы
+                    T tmp(std::forward<Args>(args)...);
+                    std::memmove(Data() + distance + 1, Data() + distance, (size_ - distance) * sizeof(T));
+                    Data()[distance] = tmp;
+                } else {
+                    new (Data() + size_) T(std::move(Data()[size_ - 1]));
+                    std::move_backward(Data() + distance, Data() + size_ - 1, Data() + size_);
+                    Data()[distance] = std::move(T(std::forward<Args>(args)...));
+                }
+            } else {
+                new (Data() + distance) T(std::forward<Args>(args)...);
+            }
+        }
+
+        ++size_;
+
+        return MakeIterator(Data() + distance);
+    }
+
+    template <typename Ref>
+    iterator Insert(const_iterator pos, Ref&& value) {
+        return Emplace(pos, std::forward<Ref>(value));
+    }
+
+    // Перезаписывает содержимое диапазоном [first, last) той же стратегией,
+    // что и operator=: присваивание поверх живых элементов, конструирование
+    // и разрушение — только на разнице размеров. Пока ёмкости хватает,
+    // повторное наполнение не выделяет память.
+    // Итераторы должны быть как минимум однонаправленными и не указывать внутрь самого вектора
+    template <typename FwdIt,
+              // Не перехватывает Assign(n, value) для целочисленных T
+              typename = std::enable_if_t<!std::is_integral_v<FwdIt>>>
+    void Assign(FwdIt first, FwdIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > Capacity()) {
+            Vector tmp(data_.GetAllocator());
+            tmp.Reserve(count);
+            std::uninitialized_copy(first, last, tmp.Data());
+            tmp.size_ = count;
+            Swap(tmp);
+            return;
+        }
+        if (size_ >= count) {
+            std::copy(first, last, Data());
+            std::destroy_n(Data() + count, size_ - count);
+        } else {
+            FwdIt mid = std::next(first, static_cast<ptrdiff_t>(size_));
+            std::copy(first, mid, Data());
+            std::uninitialized_copy(mid, last, Data() + size_);
+        }
+        size_ = count;
+    }
+
+    // Перезаписывает содержимое n копиями value по той же схеме
+    void Assign(size_t n, const T& value) {
+        if (n > Capacity()) {
+            Vector tmp(data_.GetAllocator());
+            tmp.Reserve(n);
+            std::uninitialized_fill_n(tmp.Data(), n, value);
+            tmp.size_ = n;
+            Swap(tmp);
+            return;
+        }
+        if (size_ >= n) {
+            std::fill_n(Data(), n, value);
+            std::destroy_n(Data() + n, size_ - n);
+        } else {
+            std::fill_n(Data(), size_, value);
+            std::uninitialized_fill_n(Data() + size_, n - size_, value);
+        }
+        size_ = n;
+    }
+
+    // Вливает пакет [first, last) в отсортированный по comp вектор за один
+    // обратный проход слияния: каждый существующий элемент переносится не более
+    // одного раза независимо от размера пакета — в отличие от серии одиночных
+    // Insert, где каждая вставка сдвигает весь хвост. Пакет может быть
+    // неотсортированным: он сортируется в собственном буфере
+    template <typename FwdIt, typename Compare = std::less<T>,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<FwdIt>, T>>>
+    void InsertSorted(FwdIt first, FwdIt last, Compare comp = Compare{}) {
+        // Обратное слияние не умеет откатываться с середины: бросок move
+        // оставил бы сконструированные за старым концом элементы без
+        // деструкторов. Поэтому переносы обязаны быть небросающими —
+        // условие проверяется на компиляции, как в TryReserve
+        static_assert(IsTriviallyRelocatableV<T>
+                          || (std::is_nothrow_move_constructible_v<T>
+                              && std::is_nothrow_move_assignable_v<T>),
+                      "InsertSorted requires nothrow moves");
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+
+        Vector batch(data_.GetAllocator());
+        batch.Reserve(count);
+        batch.AppendRange(first, last);
+        std::sort(batch.begin(), batch.end(), comp);
+
+        if (size_ + count > Capacity()) {
+            Reserve(Growth::Next(Capacity(), size_ + count));
+        }
+
+        // Обратное слияние: заполняем позиции с конца, забирая больший
+        // из хвостов. Инвариант dst == src + b гарантирует, что каждая
+        // позиция за старым концом конструируется ровно один раз
+        T* data = Data();
+        size_t src = size_;
+        size_t b = count;
+        size_t dst = size_ + count;
+        while (b != 0) {
+            T* from = (src != 0 && comp(batch.Data()[b - 1], data[src - 1]))
+                          ? data + --src
+                          : batch.Data() + --b;
+            --dst;
+            if (dst >= size_) {
+                new (data + dst) T(std::move(*from));
+            } else {
+                data[dst] = std::move(*from);
+            }
+        }
+        size_ += count;
+    }
+
+    // Вставляет одно значение на его позицию в отсортированном векторе;
+    // среди равных ключей — последним, так что порядок вставки стабилен
+    template <typename Compare = std::less<T>>
+    iterator EmplaceSorted(T value, Compare comp = Compare{}) {
+        const_iterator pos = std::upper_bound(cbegin(), cend(), value, comp);
+        return Emplace(pos, std::move(value));
+    }
+
+    // Дописывает [first, last) в конец, выполняя не более одной реаллокации.
+    // Итераторы должны быть как минимум однонаправленными и не указывать внутрь самого вектора
+    template <typename FwdIt>
+    void AppendRange(FwdIt first, FwdIt last) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+        if (size_ + count > Capacity()) {
+            Reserve(Growth::Next(Capacity(), size_ + count));
+        }
+        std::uninitialized_copy(first, last, Data() + size_);
+        size_ += count;
+    }
+
+    void AppendRange(Span<const T> values) {
+        AppendRange(values.begin(), values.end());
+    }
+
+    // Вставляет [first, last) перед pos за один проход и не более одной реаллокации
+    template <typename FwdIt>
+    iterator Insert(const_iterator pos, FwdIt first, FwdIt last) {
+        const size_t distance = static_cast<size_t>(Unwrap(pos) - Data());
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return MakeIterator(Data() + distance);
+        }
+
+        if (size_ + count > Capacity()) {
+            RawMemory<T, Alloc> new_data(Growth::Next(Capacity(), size_ + count), data_.GetAllocator());
+            std::uninitialized_copy(first, last, new_data + distance);
+
             try {
-                CopyN(data_.GetAddress(), distance, new_data.GetAddress());
+                CopyN(Data(), distance, new_data.GetAddress());
             } catch(...) {
-                tmp->~T();
+                std::destroy_n(new_data + distance, count);
                 throw;
             }
 
             try {
-                CopyN(data_ + distance, size_ - distance, new_data.GetAddress() + distance + 1);
+                CopyN(Data() + distance, size_ - distance, new_data + distance + count);
             } catch(...) {
-                std::destroy_n(new_data.GetAddress(), distance + 1);
+                std::destroy_n(new_data.GetAddress(), distance + count);
                 throw;
             }
 
-            std::destroy_n(data_.GetAddress(), size_);
+            std::destroy_n(Data(), size_);
+            VectorStats::OnRegrow(size_);
             data_.Swap(new_data);
+            OnBufferChange();
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(Data() + distance + count, Data() + distance, (size_ - distance) * sizeof(T));
+            std::copy(first, last, Data() + distance);
         } else {
-            if (distance < size_) {
-                new (data_ + size_) T(std::move(*(end() - 1)));
-                std::move_backward(const_cast<iterator>(pos), end() - 1, end());
-                data_[distance] = std::move(T(std::forward<Args>(args)...));
+            const size_t elems_after = size_ - distance;
+            T* old_end = Data() + size_;
+            if (elems_after > count) {
+                std::uninitialized_move(old_end - count, old_end, old_end);
+                std::move_backward(Data() + distance, old_end - count, old_end);
+                std::copy(first, last, Data() + distance);
             } else {
-                new (data_ + distance) T(std::forward<Args>(args)...);
+                // Хвост вставляемого диапазона и сдвигаемые элементы попадают за старый end
+                FwdIt mid = std::next(first, elems_after);
+                std::uninitialized_copy(mid, last, old_end);
+                std::uninitialized_move(Data() + distance, old_end, Data() + distance + count);
+                std::copy(first, mid, Data() + distance);
             }
         }
 
-        ++size_;
+        size_ += count;
+        return MakeIterator(Data() + distance);
+    }
 
-        return data_ + distance;
+    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        T* it = Unwrap(pos);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(it, it + 1, (Data() + size_ - it - 1) * sizeof(T));
+            --size_;
+        } else {
+            std::move(it + 1, Data() + size_, it);
+            Data()[--size_].~T();
+        }
+        return MakeIterator(it);
     }
 
-    template <typename Ref>
-    iterator Insert(const_iterator pos, Ref&& value) {
-        return Emplace(pos, std::forward<Ref>(value));
+    // Удаляет [first, last), сдвигая хвост один раз
+    iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        T* dst = Unwrap(first);
+        T* src = Unwrap(last);
+        const size_t count = static_cast<size_t>(src - dst);
+        if (count == 0) {
+            return MakeIterator(dst);
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memmove(dst, src, (Data() + size_ - src) * sizeof(T));
+        } else {
+            T* new_end = std::move(src, Data() + size_, dst);
+            std::destroy(new_end, Data() + size_);
+        }
+        size_ -= count;
+        return MakeIterator(dst);
+    }
+
+    // Идиома remove-erase за один проход; возвращает число удалённых элементов
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+        T* new_end = std::remove_if(Data(), Data() + size_, pred);
+        const size_t removed = static_cast<size_t>(Data() + size_ - new_end);
+        std::destroy(new_end, Data() + size_);
+        size_ -= removed;
+        return removed;
     }
 
-    iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/ {
-        std::move(std::next(const_cast<iterator>(pos)), end(), const_cast<iterator>(pos));
-        data_[--size_].~T();
-        return const_cast<iterator>(pos);
+    // Удаление за O(1) без сохранения порядка: на место pos встаёт последний элемент
+    iterator SwapRemove(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        T* it = Unwrap(pos);
+        if (it != Data() + size_ - 1) {
+            *it = std::move(Data()[size_ - 1]);
+        }
+        PopBack();
+        return MakeIterator(it);
     }
 
-    void Reserve(size_t new_capacity) {
-        if (new_capacity <= data_.Capacity()) {
+    // Резервирует ровно new_capacity без запаса — точный путь для капризных к памяти сервисов
+    VECTOR_CONSTEXPR20 void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
             return;
         }
 
-        RawMemory<T> new_data(new_capacity);
-        CopyN(data_.GetAddress(), size_, new_data.GetAddress());
-        std::destroy_n(data_.GetAddress(), size_);
+        // Тривиально перемещаемые типы аллокатор может перенести на месте
+        // (mremap и т.п.) — тогда копирование элементов не нужно вовсе
+#if VECTOR_HAS_CONSTEXPR20
+        if (!std::is_constant_evaluated())
+#endif
+        {
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                if (!IsInline() && data_.TryReallocate(new_capacity)) {
+                    OnBufferChange();
+                    return;
+                }
+            }
+        }
+
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        RelocateN(Data(), size_, new_data.GetAddress());
+        VectorStats::OnRegrow(size_);
 
         data_.Swap(new_data);
+        OnBufferChange();
+    }
+
+    // Небросающий Reserve для сборок без исключений: нехватка памяти — это
+    // false, вектор не тронут. Перенос обязан быть небросающим, поэтому API
+    // доступен только для тривиально перемещаемых либо nothrow-перемещаемых
+    // типов — условие проверяется на компиляции, try/catch не нужен
+    bool TryReserve(size_t new_capacity) noexcept {
+        static_assert(IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>,
+                      "TryReserve requires nothrow relocation");
+        if (new_capacity <= Capacity()) {
+            return true;
+        }
+
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            if (!IsInline() && data_.TryReallocate(new_capacity)) {
+                OnBufferChange();
+                return true;
+            }
+        }
+
+        RawMemory<T, Alloc> new_data(NoThrowTag{}, new_capacity, data_.GetAllocator());
+        if (new_data.GetAddress() == nullptr) {
+            return false;
+        }
+        RelocateN(Data(), size_, new_data.GetAddress());
+        VectorStats::OnRegrow(size_);
+
+        data_.Swap(new_data);
+        OnBufferChange();
+        return true;
+    }
+
+    // Небросающий EmplaceBack: nullptr при нехватке памяти, иначе указатель
+    // на сконструированный элемент. Конструктор обязан быть noexcept
+    template <typename... Args>
+    T* TryEmplaceBack(Args&&... args) noexcept {
+        static_assert(std::is_nothrow_constructible_v<T, Args...>,
+                      "TryEmplaceBack requires a nothrow constructor");
+        static_assert(IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>,
+                      "TryEmplaceBack requires nothrow relocation");
+        if (size_ == Capacity()) {
+            // Как и в EmplaceBack, элемент конструируется в новый буфер ДО
+            // переноса: аргументы могут ссылаться на элементы старого
+            RawMemory<T, Alloc> new_data(NoThrowTag{}, Growth::Next(Capacity(), size_ + 1),
+                                         data_.GetAllocator());
+            if (new_data.GetAddress() == nullptr) {
+                return nullptr;
+            }
+            ConstructAt(new_data + size_, std::forward<Args>(args)...);
+            RelocateN(Data(), size_, new_data.GetAddress());
+            VectorStats::OnRegrow(size_);
+            data_.Swap(new_data);
+            OnBufferChange();
+        } else {
+            ConstructAt(Data() + size_, std::forward<Args>(args)...);
+        }
+        T* slot = Data() + size_;
+        ++size_;
+        return slot;
+    }
+
+    template <typename Ref>
+    T* TryPushBack(Ref&& value) noexcept {
+        return TryEmplaceBack(std::forward<Ref>(value));
+    }
+
+    VECTOR_CONSTEXPR20 void Resize(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+        } else {
+            Reserve(new_size);
+            ValueConstructN(Data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Resize с параллельным конструированием/разрушением больших диапазонов
+    void ResizeParallel(size_t new_size, Parallelism par) {
+        if (new_size < size_) {
+            ParallelDestroyN(Data() + new_size, size_ - new_size, par);
+        } else {
+            Reserve(new_size);
+            ParallelValueConstructN(Data() + size_, new_size - size_, par);
+        }
+        size_ = new_size;
+    }
+
+    // Ужимает ёмкость до текущего размера; маленькие векторы возвращаются во встроенный буфер
+    void ShrinkToFit() {
+        if (IsInline() || Capacity() == size_) {
+            return;
+        }
+        if (size_ <= InlineCapacity || size_ == 0) {
+            // Буфер в куче больше не нужен. Переносим, пока буфер ещё наш:
+            // если копия бросит, вектор останется в исходном состоянии,
+            // а не «встроенным» с мусором и утечкой элементов в куче
+            RelocateN(Data(), size_, inline_.Get());
+            data_ = RawMemory<T, Alloc>(0, data_.GetAllocator());
+            OnBufferChange();
+        } else {
+            RawMemory<T, Alloc> new_data(size_, data_.GetAllocator());
+            RelocateN(Data(), size_, new_data.GetAddress());
+            data_.Swap(new_data);
+            OnBufferChange();
+        }
+    }
+
+    // Принимает внешний буфер без копирования: первые size элементов должны быть
+    // уже сконструированы, деструкторы и освобождение лягут на вектор.
+    // deleter — функция без состояния (capture-less лямбда подойдёт), которой
+    // буфер будет освобождён вместо аллокатора. Текущее содержимое разрушается
+    void Adopt(T* buf, size_t size, size_t capacity, void (*deleter)(T*, size_t)) {
+        assert(size <= capacity);
+        // Кучевой буфер обязан быть вместительнее встроенного
+        assert(capacity > InlineCapacity || capacity == 0);
+        std::destroy_n(Data(), size_);
+        data_.Adopt(buf, capacity, deleter);
+        size_ = size;
+        OnBufferChange();
     }
 
-    void Resize(size_t new_size) {
+    // Отдаёт буфер вызывающему и оставляет вектор пустым; элементы не
+    // разрушаются — их жизнью теперь управляет получатель. Для вектора,
+    // живущего во встроенном буфере, отдавать нечего: содержимое разрушается,
+    // возвращается nullptr
+    T* Release() noexcept {
+        if (IsInline()) {
+            std::destroy_n(Data(), size_);
+            size_ = 0;
+            return nullptr;
+        }
+        size_ = 0;
+        OnBufferChange();
+        return data_.Release();
+    }
+
+    // Разрушает элементы и отдаёт буфер; эквивалентно обмену с пустым вектором, но самодокументируемо
+    void Reset() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        data_ = RawMemory<T, Alloc>(0, data_.GetAllocator());
+        OnBufferChange();
+    }
+
+    // Resize без инициализации новых элементов — их содержимое до первой записи не определено
+    void ResizeForOverwrite(size_t new_size) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "ResizeForOverwrite requires a trivially default-constructible type");
         if (new_size < size_) {
-            std::destroy_n(data_ + new_size, size_ - new_size);
+            std::destroy_n(Data() + new_size, size_ - new_size);
         } else {
             Reserve(new_size);
-            std::uninitialized_value_construct_n(data_ + size_, new_size - size_);
         }
         size_ = new_size;
     }
 
-    void Swap(Vector& other) noexcept {
-        data_.Swap(other.data_);
-        std::swap(size_, other.size_);
+    void Swap(Vector& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if (IsInline() || other.IsInline()) {
+            Vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        } else {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+            OnBufferChange();
+            other.OnBufferChange();
+        }
     }
 
 private:
-    static void CopyN(T* data, size_t n, T* new_data) {
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+    // Конкурентному наполнителю нужен прямой доступ к буферу и размеру
+    friend class ConcurrentAppender<T, InlineCapacity, Alloc, Growth>;
+
+    // Элементы лежат во встроенном буфере, пока не выделен буфер в куче
+    VECTOR_CONSTEXPR20 bool IsInline() const noexcept {
+        return InlineCapacity != 0 && data_.GetAddress() == nullptr;
+    }
+
+    // Фабрики итераторов: в отладочном режиме привязывают итератор к
+    // текущему поколению буфера, в release просто возвращают указатель
+    VECTOR_CONSTEXPR20 iterator MakeIterator(T* p) noexcept {
+#if VECTOR_HAS_DEBUG_ITERATORS
+        return iterator(p, this, generation_);
+#else
+        return p;
+#endif
+    }
+
+    VECTOR_CONSTEXPR20 const_iterator MakeIterator(const T* p) const noexcept {
+#if VECTOR_HAS_DEBUG_ITERATORS
+        return const_iterator(p, this, generation_);
+#else
+        return p;
+#endif
+    }
+
+    // Разворачивает позицию в голый указатель для внутренней арифметики;
+    // в отладочном режиме заодно проверяет, что итератор не протух
+    VECTOR_CONSTEXPR20 T* Unwrap(const_iterator pos) noexcept {
+#if VECTOR_HAS_DEBUG_ITERATORS
+        assert(pos.IsValid());
+        return const_cast<T*>(pos.Raw());
+#else
+        return const_cast<T*>(pos);
+#endif
+    }
+
+    // Фиксирует смену буфера: все выданные ранее итераторы протухают
+    VECTOR_CONSTEXPR20 void OnBufferChange() noexcept {
+#if VECTOR_HAS_DEBUG_ITERATORS
+        ++generation_;
+#endif
+    }
+
+    VECTOR_CONSTEXPR20 T* Data() noexcept {
+        return IsInline() ? inline_.Get() : data_.GetAddress();
+    }
+
+    VECTOR_CONSTEXPR20 const T* Data() const noexcept {
+        return const_cast<Vector&>(*this).Data();
+    }
+
+    // Конструирует объект по адресу p; в константных вычислениях placement new недоступен
+    template <typename... Args>
+    static VECTOR_CONSTEXPR20 T* ConstructAt(T* p, Args&&... args) {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            return std::construct_at(p, std::forward<Args>(args)...);
+        }
+#endif
+        return new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+    }
+
+    static VECTOR_CONSTEXPR20 void ValueConstructN(T* p, size_t n) {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                std::construct_at(p + i);
+            }
+            return;
+        }
+#endif
+        std::uninitialized_value_construct_n(p, n);
+    }
+
+    // Переносит n элементов в новый буфер; для тривиально копируемых типов — одним memcpy
+    static VECTOR_CONSTEXPR20 void CopyN(T* data, size_t n, T* new_data) {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < n; ++i) {
+                std::construct_at(new_data + i, std::move(data[i]));
+            }
+            return;
+        }
+#endif
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n != 0) {
+                std::memcpy(new_data, data, n * sizeof(T));
+            }
+        } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
             std::uninitialized_move_n(data, n, new_data);
         } else {
             std::uninitialized_copy_n(data, n, new_data);
         }
     }
 
-    RawMemory<T> data_;
+    // Ниже этого размера куска параллелизм не окупается
+    static constexpr size_t MIN_PARALLEL_CHUNK = size_t{1} << 16;
+
+    // Разбивает [0, n) на куски и выполняет f(begin, count) в worker-потоках;
+    // последний кусок обрабатывается в вызывающем потоке
+    template <typename F>
+    static void ParallelPartition(size_t n, Parallelism par, F f) {
+        size_t threads = par.thread_count != 0 ? par.thread_count : std::thread::hardware_concurrency();
+        threads = std::min(threads, n / MIN_PARALLEL_CHUNK);
+        if (threads <= 1) {
+            f(size_t{0}, n);
+            return;
+        }
+
+        const size_t chunk = n / threads;
+        Vector<std::thread> workers;
+        workers.Reserve(threads - 1);
+        size_t begin = 0;
+        for (size_t t = 0; t + 1 < threads; ++t) {
+            workers.EmplaceBack([f, begin, chunk] {
+                f(begin, chunk);
+            });
+            begin += chunk;
+        }
+        f(begin, n - begin);
+        for (size_t t = 0; t < workers.Size(); ++t) {
+            workers[t].join();
+        }
+    }
+
+    static void ParallelValueConstructN(T* p, size_t n, Parallelism par) {
+        if constexpr (std::is_nothrow_default_constructible_v<T>) {
+            ParallelPartition(n, par, [p](size_t begin, size_t count) {
+                std::uninitialized_value_construct_n(p + begin, count);
+            });
+        } else {
+            std::uninitialized_value_construct_n(p, n);
+        }
+    }
+
+    static void ParallelCopyN(const T* src, size_t n, T* dst, Parallelism par) {
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            ParallelPartition(n, par, [src, dst](size_t begin, size_t count) {
+                std::uninitialized_copy_n(src + begin, count, dst + begin);
+            });
+        } else {
+            std::uninitialized_copy_n(src, n, dst);
+        }
+    }
+
+    static void ParallelDestroyN(T* p, size_t n, Parallelism par) {
+        if constexpr (std::is_nothrow_destructible_v<T>) {
+            ParallelPartition(n, par, [p](size_t begin, size_t count) {
+                std::destroy_n(p + begin, count);
+            });
+        } else {
+            std::destroy_n(p, n);
+        }
+    }
+
+    // Переносит n элементов и завершает их жизнь в источнике; для тривиально
+    // перемещаемых типов — один memcpy без прохода деструкторов
+    static VECTOR_CONSTEXPR20 void RelocateN(T* data, size_t n, T* new_data) {
+#if VECTOR_HAS_CONSTEXPR20
+        if (std::is_constant_evaluated()) {
+            CopyN(data, n, new_data);
+            std::destroy_n(data, n);
+            return;
+        }
+#endif
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            if (n != 0) {
+                // static_cast<void*> гасит -Wclass-memaccess: для опт-ин типов побайтовый перенос корректен
+                std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data), n * sizeof(T));
+            }
+        } else {
+            CopyN(data, n, new_data);
+            std::destroy_n(data, n);
+        }
+    }
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
+#if VECTOR_HAS_DEBUG_ITERATORS
+    size_t generation_ = 0;
+#endif
+    InlineStorage<T, InlineCapacity> inline_;
 };
+
+// Сравнения. Равенство для типов с однозначным байтовым представлением —
+// один memcmp по непрерывному буферу (float сюда не попадает: из-за NaN и
+// знаковых нулей он сравнивается поэлементно). Порядок — всегда
+// лексикографический поэлементный: memcmp не согласован с operator< даже
+// для знаковых целых
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator==(const Vector<T, C1, A1, G1>& lhs,
+                                   const Vector<T, C2, A2, G2>& rhs) {
+    if (lhs.Size() != rhs.Size()) {
+        return false;
+    }
+#if VECTOR_HAS_CONSTEXPR20
+    if (!std::is_constant_evaluated())
+#endif
+    {
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            return lhs.Size() == 0
+                || std::memcmp(lhs.begin(), rhs.begin(), lhs.Size() * sizeof(T)) == 0;
+        }
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator!=(const Vector<T, C1, A1, G1>& lhs,
+                                   const Vector<T, C2, A2, G2>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator<(const Vector<T, C1, A1, G1>& lhs,
+                                  const Vector<T, C2, A2, G2>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator>(const Vector<T, C1, A1, G1>& lhs,
+                                  const Vector<T, C2, A2, G2>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator<=(const Vector<T, C1, A1, G1>& lhs,
+                                   const Vector<T, C2, A2, G2>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, size_t C1, typename A1, typename G1,
+          size_t C2, typename A2, typename G2>
+VECTOR_CONSTEXPR20 bool operator>=(const Vector<T, C1, A1, G1>& lhs,
+                                   const Vector<T, C2, A2, G2>& rhs) {
+    return !(lhs < rhs);
+}
+
+// Вектор как ключ unordered-контейнеров — делегирует в Vector::Hash()
+namespace std {
+
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth>
+struct hash<Vector<T, InlineCapacity, Alloc, Growth>> {
+    size_t operator()(const Vector<T, InlineCapacity, Alloc, Growth>& v) const {
+        return v.Hash();
+    }
+};
+
+}  // namespace std
+
+// Фоновый жнец для DestroyAsync: единственный ленивый поток, разбирающий
+// очередь отложенных разрушений. Деструктор синглтона дожидается опустошения
+// очереди, так что к завершению процесса всё разрушено и освобождено
+class VectorReaper {
+public:
+    static VectorReaper& Instance() {
+        static VectorReaper reaper;
+        return reaper;
+    }
+
+    void Enqueue(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.PushBack(std::move(task));
+            if (!worker_.joinable()) {
+                worker_ = std::thread(&VectorReaper::Run, this);
+            }
+        }
+        wake_.notify_one();
+    }
+
+    // Дожидается, пока всё поставленное будет разрушено; для тестов и
+    // shutdown-хуков, в штатной работе не нужен
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] {
+            return pending_.Size() == 0 && !busy_;
+        });
+    }
+
+private:
+    VectorReaper() = default;
+
+    ~VectorReaper() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [this] {
+                return pending_.Size() != 0 || stop_;
+            });
+            if (pending_.Size() == 0) {
+                break;  // stop_ и пустая очередь — можно уходить
+            }
+            Vector<std::function<void()>> batch = std::move(pending_);
+            busy_ = true;
+            lock.unlock();
+            for (size_t i = 0; i < batch.Size(); ++i) {
+                batch[i]();
+            }
+            lock.lock();
+            busy_ = false;
+            idle_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    Vector<std::function<void()>> pending_;
+    std::thread worker_;
+    bool busy_ = false;
+    bool stop_ = false;
+};
+
+template <typename T, size_t InlineCapacity, typename Alloc, typename Growth>
+void Vector<T, InlineCapacity, Alloc, Growth>::DestroyAsync() {
+    if (IsInline()) {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        return;
+    }
+    auto* carcass = new Vector(std::move(*this));
+    OnBufferChange();
+    VectorReaper::Instance().Enqueue([carcass]() noexcept {
+        delete carcass;
+    });
+}
@@ -0,0 +1,350 @@
+// Бенчмарки Vector против std::vector. Результаты — в items_per_second,
+// т.е. регрессии видны как падение числа элементов в секунду. У каждого
+// замера есть пара *_Std на std::vector — без неё число само по себе
+// ничего не говорит.
+//
+//   cmake -S benchmarks -B build-bench && cmake --build build-bench
+//   ./build-bench/vector_benchmarks
+
+#include <benchmark/benchmark.h>
+
+#include "vector.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Тривиально копируемая 16-байтовая запись заявки
+struct Order {
+    int64_t price;
+    int32_t qty;
+    int32_t id;
+};
+
+// Нетривиальный тип с nothrow-перемещением — при регрове переносится
+struct Name {
+    Name() = default;
+    explicit Name(int id) : value(std::to_string(id)) {}
+    std::string value;
+};
+
+// Нетривиальный тип с бросающим перемещением — при регрове копируется
+struct SlowName {
+    SlowName() = default;
+    explicit SlowName(int id) : value(std::to_string(id)) {}
+    SlowName(const SlowName&) = default;
+    SlowName(SlowName&& other) : value(std::move(other.value)) {}  // не noexcept
+    SlowName& operator=(const SlowName&) = default;
+    SlowName& operator=(SlowName&&) = default;
+    std::string value;
+};
+
+template <typename Container, typename Value>
+void PushBackGrowCurve(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        Container v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.push_back(Value{});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Value>
+void PushBackGrowCurveVector(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        Vector<Value> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.PushBack(Value{});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_PushBack_Trivial(benchmark::State& state) {
+    PushBackGrowCurveVector<Order>(state);
+}
+
+void BM_PushBack_Trivial_Std(benchmark::State& state) {
+    PushBackGrowCurve<std::vector<Order>, Order>(state);
+}
+
+void BM_PushBack_NonTrivial(benchmark::State& state) {
+    PushBackGrowCurveVector<Name>(state);
+}
+
+void BM_PushBack_NonTrivial_Std(benchmark::State& state) {
+    PushBackGrowCurve<std::vector<Name>, Name>(state);
+}
+
+void BM_EmplaceBack_NonTrivial(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        Vector<Name> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_EmplaceBack_NonTrivial_Std(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        std::vector<Name> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.emplace_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Вставка и удаление в начале/середине/конце; позиция — доля длины в
+// процентах. Наполнение вектора — вне замера, меряется только сдвиг хвоста
+void BM_InsertAt(benchmark::State& state) {
+    const int64_t n = 10'000;
+    const int64_t percent = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vector<Order> v;
+        v.Reserve(n + 1);
+        for (int64_t i = 0; i < n; ++i) {
+            v.PushBack(Order{i, 1, 2});
+        }
+        state.ResumeTiming();
+        v.Insert(v.cbegin() + n * percent / 100, Order{0, 0, 0});
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_InsertAt_Std(benchmark::State& state) {
+    const int64_t n = 10'000;
+    const int64_t percent = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Order> v;
+        v.reserve(n + 1);
+        for (int64_t i = 0; i < n; ++i) {
+            v.push_back(Order{i, 1, 2});
+        }
+        state.ResumeTiming();
+        v.insert(v.cbegin() + n * percent / 100, Order{0, 0, 0});
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_EraseAt(benchmark::State& state) {
+    const int64_t n = 10'000;
+    const int64_t percent = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vector<Order> v;
+        v.Reserve(n);
+        for (int64_t i = 0; i < n; ++i) {
+            v.PushBack(Order{i, 1, 2});
+        }
+        state.ResumeTiming();
+        v.Erase(v.cbegin() + (n - 1) * percent / 100);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_EraseAt_Std(benchmark::State& state) {
+    const int64_t n = 10'000;
+    const int64_t percent = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Order> v;
+        v.reserve(n);
+        for (int64_t i = 0; i < n; ++i) {
+            v.push_back(Order{i, 1, 2});
+        }
+        state.ResumeTiming();
+        v.erase(v.cbegin() + (n - 1) * percent / 100);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_ReserveThenFill(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        Vector<Order> v;
+        v.Reserve(n);
+        for (int64_t i = 0; i < n; ++i) {
+            v.PushBack(Order{i, 1, 2});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_ReserveThenFill_Std(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        std::vector<Order> v;
+        v.reserve(n);
+        for (int64_t i = 0; i < n; ++i) {
+            v.push_back(Order{i, 1, 2});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_NaiveFill(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        Vector<Order> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.PushBack(Order{i, 1, 2});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_NaiveFill_Std(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        std::vector<Order> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.push_back(Order{i, 1, 2});
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Быстрый путь operator=: ёмкости хватает, буфер переиспользуется
+void BM_CopyAssign_FastPath(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    Vector<Order> src(n);
+    Vector<Order> dst(n);
+    for (auto _ : state) {
+        dst = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_CopyAssign_FastPath_Std(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    std::vector<Order> src(n);
+    std::vector<Order> dst(n);
+    for (auto _ : state) {
+        dst = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Медленный путь operator=: нужна реаллокация через копию и Swap
+void BM_CopyAssign_SlowPath(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    Vector<Order> src(n);
+    for (auto _ : state) {
+        Vector<Order> dst;
+        dst = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_CopyAssign_SlowPath_Std(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    std::vector<Order> src(n);
+    for (auto _ : state) {
+        std::vector<Order> dst;
+        dst = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Перенос при регрове: nothrow-move тип перемещается, бросающий — копируется
+template <typename Value>
+void RelocationThroughReserve(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vector<Value> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        state.ResumeTiming();
+        v.Reserve(v.Capacity() * 2);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Value>
+void RelocationThroughReserveStd(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Value> v;
+        for (int64_t i = 0; i < n; ++i) {
+            v.emplace_back(static_cast<int>(i));
+        }
+        state.ResumeTiming();
+        v.reserve(v.capacity() * 2);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_Relocate_Move(benchmark::State& state) {
+    RelocationThroughReserve<Name>(state);
+}
+
+void BM_Relocate_Move_Std(benchmark::State& state) {
+    RelocationThroughReserveStd<Name>(state);
+}
+
+void BM_Relocate_Copy(benchmark::State& state) {
+    RelocationThroughReserve<SlowName>(state);
+}
+
+void BM_Relocate_Copy_Std(benchmark::State& state) {
+    RelocationThroughReserveStd<SlowName>(state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PushBack_Trivial)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBack_Trivial_Std)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushBack_NonTrivial)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_PushBack_NonTrivial_Std)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_EmplaceBack_NonTrivial)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_EmplaceBack_NonTrivial_Std)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_InsertAt)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_InsertAt_Std)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_EraseAt)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_EraseAt_Std)->Arg(0)->Arg(50)->Arg(100);
+BENCHMARK(BM_ReserveThenFill)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ReserveThenFill_Std)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_NaiveFill)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_NaiveFill_Std)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_CopyAssign_FastPath)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_CopyAssign_FastPath_Std)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_CopyAssign_SlowPath)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_CopyAssign_SlowPath_Std)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Relocate_Move)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Relocate_Move_Std)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Relocate_Copy)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Relocate_Copy_Std)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_MAIN();